@@ -0,0 +1,748 @@
+/**
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                   *
+ *   Payroll Pro 2.0 - The payroll benchmarks                        *
+ *                                                                   *
+ *   Purpose:                                                        *
+ *   Benchmarks every hot path of the payroll core (the report       *
+ *   builders, the kernels, the lookups & the formatters) over       *
+ *   synthetic workloads (the program's own generator) at 1k, 100k   *
+ *   & 10M payments, next to the paths they replaced (as baselines), *
+ *   so any two commits can be compared:                             *
+ *                                                                   *
+ *   ./payroll_bench --benchmark_out=results.json                    *
+ *                   --benchmark_out_format=json                     *
+ *                                                                   *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ **/
+
+#include <benchmark/benchmark.h>
+#include <map>
+#include "payroll.h"
+
+#ifdef PAYROLL_HAS_AVX2_KERNELS
+#include <immintrin.h> // For the double-based AVX2 kernels it compares against
+#endif
+
+using namespace std;
+
+
+/**
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                         *
+ *                   GLOBAL CONSTANTS                      *
+ *                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ **/
+
+constexpr uint64_t SYNTHETIC_PAYROLL_SEED = 20240718; // Fixed, so every run (& every commit) benchmarks the very same data
+constexpr size_t SYNTHETIC_PAYMENTS_PER_EMPLOYEE = 50; // About a year of weekly payments
+constexpr size_t BENCHMARK_SCENARIOS_AMOUNT = 64; // What-if scenarios of the simulation benchmark
+constexpr size_t BENCHMARK_QUERIES_AMOUNT = 1024; // Pre-generated random queries (ids, ranges of pay dates), cycled through by the lookup benchmarks
+constexpr size_t LATENCY_BENCHMARK_PAYMENTS_AMOUNT = 10000000; // Payments added (& timed one by one) by the latency benchmarks
+constexpr int DOUBLE_KERNEL_FIELDS = 6; // regHours, otHours, regPay, otPay, fica & socSec, in that order, all of them doubles
+
+
+/**
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                         *
+ *                STRUCTURE DEFINITIONS                    *
+ *                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ **/
+
+using AggregationKernel = void (*)(const double *, const double *, const PayrollPolicy *, size_t, bool, KernelLanes &);
+using DoubleAggregationKernel = void (*)(const double *, const double *, size_t, double (&)[DOUBLE_KERNEL_FIELDS][KERNEL_LANES]);
+
+// A synthetic company: its employees, & all the payments they received
+struct SyntheticPayroll {
+    EmployeeRegistry employeeRegistry;
+    PaymentLedger paymentLedger;
+};
+
+// A payment as the ledger used to keep it, before the payment columns: a record with its own strings, in a vector that moves all of them whenever it grows
+struct StringPayment {
+    std::string employeeId;
+    std::string firstName;
+    std::string lastName;
+    double hoursWorked {0.0};
+    double regRate {0.0};
+    int32_t payDate {0};
+    PayrollPolicy payrollPolicy {STANDARD_PAYROLL_POLICY};
+};
+
+// Discards everything written to the console while it lives (with the console in the same format as the program's tables), so the printing benchmarks
+// measure the formatting of the tables alone, & not the terminal
+struct ConsoleOutputDiscarder : streambuf {
+    ConsoleOutputDiscarder();
+    ~ConsoleOutputDiscarder() override;
+
+protected:
+    int overflow(int character) override { return character; }
+    streamsize xsputn(const char *, const streamsize amount) override { return amount; }
+
+private:
+    streambuf *consoleBuffer;
+    ios::fmtflags consoleFlags;
+    streamsize consolePrecision;
+};
+
+
+/**
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                         *
+ *           CUSTOM MADE FUNCTIONS PROTOTYPES              *
+ *                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ **/
+
+// Gets the SyntheticWorkload with a given amount of payments (one employee per 50 of them), from a fixed seed, optionally with some overtime-exempt employees
+SyntheticWorkload createSyntheticWorkload(size_t, bool);
+
+// Generates the SyntheticPayroll of a given amount of payments (& policies mix), from a fixed seed
+unique_ptr<SyntheticPayroll> generateSyntheticPayroll(size_t, bool);
+
+// Gets the SyntheticPayroll with a given amount of payments (& policies mix), generating it only the first time it's asked for
+const SyntheticPayroll &getSyntheticPayroll(size_t, bool);
+
+// Draws from a given generator one of the pay dates of a given PaymentLedger (which must have payments)
+int32_t drawPayDate(const PaymentLedger &, mt19937_64 &);
+
+// Gets all the Payment structure variables of the SyntheticPayroll with a given amount of payments (standard policies only), gathering them only the first time it's asked for
+const vector<Payment> &getSyntheticPayments(size_t);
+
+// Creates an EmployeeRegistry with a given amount of employees (& no payments at all), from a fixed seed
+EmployeeRegistry createSyntheticEmployeeRegistry(size_t);
+
+// Draws from a given generator a new payment to one of the employees of a given SyntheticPayroll, in one of its pay dates, into the reference of a given Payment
+void drawPayment(const SyntheticPayroll &, mt19937_64 &, Payment &);
+
+// Sets the percentiles 50, 99 & 99.9 of some given latencies (in nanoseconds) as the counters of a given benchmark
+void setLatencyPercentiles(benchmark::State &, vector<int64_t> &);
+
+// Sets the amounts of payments of a benchmark: 1k, 100k & 10M
+void applyPaymentScales(benchmark::internal::Benchmark *);
+
+// Sets the amounts of employees of a benchmark: 10k, 100k & 1M
+void applyEmployeeScales(benchmark::internal::Benchmark *);
+
+// Sets the amounts of payments (1k, 100k & 10M) & of report workers (from 1 up to one per CPU core, doubling them) of a benchmark
+void applyReportWorkersScales(benchmark::internal::Benchmark *);
+
+// The baseline of the portable aggregation kernels, with the money as plain doubles (neither rounded to the cent, nor added up as integers), for the standard payroll policy
+void accumulateDoublePaymentColumnsScalar(const double *, const double *, size_t, double (&)[DOUBLE_KERNEL_FIELDS][KERNEL_LANES]);
+
+#ifdef PAYROLL_HAS_AVX2_KERNELS
+// The baseline of the AVX2 aggregation kernels, with the money as plain doubles (neither rounded to the cent, nor added up as integers), for the standard payroll policy
+__attribute__((target("avx2"))) void accumulateDoublePaymentColumnsAvx2(const double *, const double *, size_t, double (&)[DOUBLE_KERNEL_FIELDS][KERNEL_LANES]);
+#endif
+
+// The baseline of the portable aggregation kernels' payroll policies: the standard payroll policy's rules hard-coded (neither looked up nor dispatched), with the money
+// rounded to the cent & added up as integers just like them. The payroll policies of the payments (& whether they are mixed) get ignored
+void accumulateHardCodedPaymentColumnsScalar(const double *, const double *, const PayrollPolicy *, size_t, bool, KernelLanes &);
+
+// The baseline of generateEmployeeId(): a new random id as the 36 characters string it used to be, drawing each hexadecimal digit from a given generator on its own
+string generateUuidString(mt19937 &);
+
+// The baseline of monetizeDouble(): a given amount of money, formatted through a stringstream & a few temporary strings, like before the table renderer
+string monetizeDoubleThroughStreams(double);
+
+// The baseline of printPaymentsPage(): prints a given vector of Payment structure variables as a table, field by field into the console (flushing every line), like before the table renderer
+void printPaymentsThroughStreams(const vector<Payment> &);
+
+// The baseline of renderLineUnderPaymentsTableRow(): prints the line under each row of the table of payments, dash by dash, for a given largest full name's length
+void printLineUnderPaymentsTableRowThroughStreams(int);
+
+
+/**
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                         *
+ *                      BENCHMARKS                         *
+ *                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ **/
+
+// The company's addition PayrollReport, through the aggregation kernels (state.range(1) is the amount of workers, so it shows how the report scales with them)
+void benchmarkCreateAdditionPayrollReportInParallel(benchmark::State &state, const bool withMixedPolicies) {
+    const SyntheticPayroll &syntheticPayroll = getSyntheticPayroll(static_cast<size_t>(state.range(0)), withMixedPolicies);
+    ThreadPool threadPool(static_cast<unsigned>(state.range(1)));
+    for (auto _: state) benchmark::DoNotOptimize(createAdditionPayrollReportInParallel(syntheticPayroll.paymentLedger.columns, threadPool));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK_CAPTURE(benchmarkCreateAdditionPayrollReportInParallel, standard, false)->Apply(applyReportWorkersScales)->UseRealTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(benchmarkCreateAdditionPayrollReportInParallel, mixed, true)->Apply(applyReportWorkersScales)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+// A given aggregation kernel alone, chunk by chunk of the columns, on the calling thread
+void benchmarkAggregationKernel(benchmark::State &state, const AggregationKernel kernel, const bool withMixedPolicies) {
+    const PaymentColumns &columns = getSyntheticPayroll(static_cast<size_t>(state.range(0)), withMixedPolicies).paymentLedger.columns;
+    for (auto _: state) {
+        KernelLanes lanes;
+        for (size_t chunk = 0; chunk < columns.hoursWorked.chunksAmount(); chunk++) {
+            kernel(columns.hoursWorked.chunkData(chunk), columns.regRates.chunkData(chunk), columns.payrollPolicies.chunkData(chunk), columns.hoursWorked.chunkSize(chunk),
+                   columns.hasMixedPayrollPolicies(), lanes);
+        }
+        benchmark::DoNotOptimize(lanes);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK_CAPTURE(benchmarkAggregationKernel, scalar_standard, accumulatePaymentColumnsScalar, false)->Apply(applyPaymentScales)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(benchmarkAggregationKernel, scalar_mixed, accumulatePaymentColumnsScalar, true)->Apply(applyPaymentScales)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(benchmarkAggregationKernel, hard_coded_scalar_standard, accumulateHardCodedPaymentColumnsScalar, false)->Apply(applyPaymentScales)->Unit(benchmark::kMicrosecond);
+#ifdef PAYROLL_HAS_AVX2_KERNELS
+BENCHMARK_CAPTURE(benchmarkAggregationKernel, avx2_standard, accumulatePaymentColumnsAvx2, false)->Apply(applyPaymentScales)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(benchmarkAggregationKernel, avx2_mixed, accumulatePaymentColumnsAvx2, true)->Apply(applyPaymentScales)->Unit(benchmark::kMicrosecond);
+#endif
+
+// A given baseline aggregation kernel alone (the money as plain doubles), chunk by chunk of the standard payroll policy's columns, to compare with the ones above
+void benchmarkDoubleAggregationKernel(benchmark::State &state, const DoubleAggregationKernel kernel) {
+    const PaymentColumns &columns = getSyntheticPayroll(static_cast<size_t>(state.range(0)), false).paymentLedger.columns;
+    for (auto _: state) {
+        double lanes[DOUBLE_KERNEL_FIELDS][KERNEL_LANES] {};
+        for (size_t chunk = 0; chunk < columns.hoursWorked.chunksAmount(); chunk++) {
+            kernel(columns.hoursWorked.chunkData(chunk), columns.regRates.chunkData(chunk), columns.hoursWorked.chunkSize(chunk), lanes);
+        }
+        benchmark::DoNotOptimize(lanes);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK_CAPTURE(benchmarkDoubleAggregationKernel, scalar_standard, accumulateDoublePaymentColumnsScalar)->Apply(applyPaymentScales)->Unit(benchmark::kMicrosecond);
+#ifdef PAYROLL_HAS_AVX2_KERNELS
+BENCHMARK_CAPTURE(benchmarkDoubleAggregationKernel, avx2_standard, accumulateDoublePaymentColumnsAvx2)->Apply(applyPaymentScales)->Unit(benchmark::kMicrosecond);
+#endif
+
+// The addition & average EmployeePayrollReports of every employee, in a single pass over the payments
+void benchmarkCreateAllEmployeesPayrollReportSummaries(benchmark::State &state) {
+    const PaymentLedger &paymentLedger = getSyntheticPayroll(static_cast<size_t>(state.range(0)), false).paymentLedger;
+    for (auto _: state) benchmark::DoNotOptimize(createAllEmployeesPayrollReportSummaries(paymentLedger, BY_NET_PAY));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(benchmarkCreateAllEmployeesPayrollReportSummaries)->Apply(applyPaymentScales)->Unit(benchmark::kMicrosecond);
+
+// The baseline of the single pass above: the addition & average EmployeePayrollReports of every current employee, one employee after another (through their index of payments)
+void benchmarkCreateEachEmployeePayrollReportSummary(benchmark::State &state) {
+    const SyntheticPayroll &syntheticPayroll = getSyntheticPayroll(static_cast<size_t>(state.range(0)), false);
+    const EmployeeRegistry &employeeRegistry = syntheticPayroll.employeeRegistry;
+    for (auto _: state) {
+        for (size_t position = 0; position < employeeRegistry.size(); position++) {
+            benchmark::DoNotOptimize(createEmployeePayrollReportSummary(syntheticPayroll.paymentLedger, employeeRegistry.employees[position]));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(benchmarkCreateEachEmployeePayrollReportSummary)->Apply(applyPaymentScales)->Unit(benchmark::kMicrosecond);
+
+// The company's addition & average PayrollReports, from all its Payment structure variables: fused in a single pass, or in two passes (one per report, like before the fused engine)
+void benchmarkCreateCompanyPayrollReports(benchmark::State &state, const bool isFused) {
+    const vector<Payment> &payments = getSyntheticPayments(static_cast<size_t>(state.range(0)));
+    for (auto _: state) {
+        if (isFused) {
+            benchmark::DoNotOptimize(createPayrollReportSummary(payments));
+        } else {
+            benchmark::DoNotOptimize(createAdditionPayrollReport(payments));
+            benchmark::DoNotOptimize(createAveragePayrollReport(payments));
+        }
+    }
+    state.counters["passes"] = isFused ? 1 : 2; // Over all the payments, per iteration
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK_CAPTURE(benchmarkCreateCompanyPayrollReports, fused, true)->Apply(applyPaymentScales)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(benchmarkCreateCompanyPayrollReports, two_passes, false)->Apply(applyPaymentScales)->Unit(benchmark::kMicrosecond);
+
+// The addition & average EmployeePayrollReports of a random current employee, through the employee's index of payments
+void benchmarkCreateCurrentEmployeePayrollReportSummary(benchmark::State &state) {
+    const SyntheticPayroll &syntheticPayroll = getSyntheticPayroll(static_cast<size_t>(state.range(0)), false);
+    const EmployeeRegistry &employeeRegistry = syntheticPayroll.employeeRegistry;
+    ThreadPool threadPool(1);
+    mt19937_64 generator(SYNTHETIC_PAYROLL_SEED);
+    size_t query = 0;
+    for (auto _: state) {
+        const Employee &employee = employeeRegistry.employees[generator() % employeeRegistry.size()];
+        benchmark::DoNotOptimize(createCurrentEmployeePayrollReportSummary(syntheticPayroll.paymentLedger, employee, threadPool));
+        query++;
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(query));
+}
+BENCHMARK(benchmarkCreateCurrentEmployeePayrollReportSummary)->Apply(applyPaymentScales);
+
+// The addition PayrollReport of a random range of pay dates, from the PayDateIndex
+void benchmarkCreateAdditionPayrollReportOfPayDates(benchmark::State &state) {
+    const PaymentLedger &paymentLedger = getSyntheticPayroll(static_cast<size_t>(state.range(0)), false).paymentLedger;
+    mt19937_64 generator(SYNTHETIC_PAYROLL_SEED);
+    vector<pair<int32_t, int32_t>> payDateRanges(BENCHMARK_QUERIES_AMOUNT);
+    for (auto &[firstPayDate, lastPayDate]: payDateRanges) {
+        firstPayDate = drawPayDate(paymentLedger, generator);
+        lastPayDate = drawPayDate(paymentLedger, generator);
+        if (lastPayDate < firstPayDate) swap(firstPayDate, lastPayDate);
+    }
+
+    size_t query = 0;
+    for (auto _: state) {
+        const auto &[firstPayDate, lastPayDate] = payDateRanges[query++ % BENCHMARK_QUERIES_AMOUNT];
+        benchmark::DoNotOptimize(createAdditionPayrollReportOfPayDates(paymentLedger, firstPayDate, lastPayDate));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(query));
+}
+BENCHMARK(benchmarkCreateAdditionPayrollReportOfPayDates)->Apply(applyPaymentScales);
+
+// The company's addition PayrollReport under 64 what-if scenarios at once
+void benchmarkSimulatePayrollScenarios(benchmark::State &state) {
+    const PaymentColumns &columns = getSyntheticPayroll(static_cast<size_t>(state.range(0)), true).paymentLedger.columns;
+    vector<PayrollScenario> scenarios(BENCHMARK_SCENARIOS_AMOUNT);
+    for (size_t scenario = 0; scenario < scenarios.size(); scenario++) {
+        copy(begin(PAYROLL_RULES), end(PAYROLL_RULES), scenarios[scenario].rulesByPolicy);
+        scenarios[scenario].rulesByPolicy[STANDARD_PAYROLL_POLICY].maxRegHours = 30 + static_cast<double>(scenario % 16);
+    }
+    ThreadPool threadPool(1);
+    for (auto _: state) benchmark::DoNotOptimize(simulatePayrollScenarios(columns, scenarios, threadPool));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0) * static_cast<int64_t>(scenarios.size())); // Payment-scenarios
+}
+BENCHMARK(benchmarkSimulatePayrollScenarios)->Apply(applyPaymentScales)->Unit(benchmark::kMillisecond);
+
+// Adding a payment to the ledger (the company's running report, the pay date's node & the employee's index included), through the same path as the menu's
+void benchmarkInsertPayment(benchmark::State &state) {
+    const SyntheticPayroll &syntheticPayroll = getSyntheticPayroll(1000, false);
+    PaymentLedger paymentLedger; // Grows along the whole benchmark
+    mt19937_64 generator(SYNTHETIC_PAYROLL_SEED);
+    Payment payment;
+    for (auto _: state) {
+        drawPayment(syntheticPayroll, generator, payment);
+        insertPayment(paymentLedger, payment);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(benchmarkInsertPayment);
+
+// Adding 10M payments to an empty ledger (through the same path as the menu's), each one timed on its own, to get the percentiles of its latency besides the mean
+void benchmarkInsertPaymentLatency(benchmark::State &state) {
+    const SyntheticPayroll &syntheticPayroll = getSyntheticPayroll(1000, false);
+    PaymentLedger paymentLedger; // Grows along the whole benchmark
+    mt19937_64 generator(SYNTHETIC_PAYROLL_SEED);
+    Payment payment;
+    vector<int64_t> latencies;
+    latencies.reserve(LATENCY_BENCHMARK_PAYMENTS_AMOUNT);
+    for (auto _: state) {
+        drawPayment(syntheticPayroll, generator, payment);
+        const auto start = chrono::steady_clock::now();
+        insertPayment(paymentLedger, payment);
+        latencies.push_back(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count());
+    }
+    setLatencyPercentiles(state, latencies);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(benchmarkInsertPaymentLatency)->Iterations(LATENCY_BENCHMARK_PAYMENTS_AMOUNT);
+
+// The baseline of the one above: adding 10M payments, as records with their own strings, to a vector that moves all of them whenever it grows (only the addition gets timed)
+void benchmarkPushStringPaymentLatency(benchmark::State &state) {
+    const SyntheticPayroll &syntheticPayroll = getSyntheticPayroll(1000, false);
+    vector<StringPayment> stringPayments; // Grows along the whole benchmark
+    mt19937_64 generator(SYNTHETIC_PAYROLL_SEED);
+    Payment payment;
+    vector<int64_t> latencies;
+    latencies.reserve(LATENCY_BENCHMARK_PAYMENTS_AMOUNT);
+    for (auto _: state) {
+        drawPayment(syntheticPayroll, generator, payment);
+        StringPayment stringPayment {.employeeId = employeeIdToString(payment.employeeId), .firstName = string(payment.firstName), .lastName = string(payment.lastName),
+                                     .hoursWorked = payment.hoursWorked, .regRate = payment.regRate, .payDate = payment.payDate, .payrollPolicy = payment.payrollPolicy};
+        const auto start = chrono::steady_clock::now();
+        stringPayments.push_back(move(stringPayment));
+        latencies.push_back(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count());
+    }
+    setLatencyPercentiles(state, latencies);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(benchmarkPushStringPaymentLatency)->Iterations(LATENCY_BENCHMARK_PAYMENTS_AMOUNT);
+
+// Generating a whole synthetic workload into an empty system (state.range(1) is the amount of workers)
+void benchmarkGenerateSyntheticWorkload(benchmark::State &state) {
+    const SyntheticWorkload workload = createSyntheticWorkload(static_cast<size_t>(state.range(0)), true);
+    ThreadPool threadPool(static_cast<unsigned>(state.range(1)));
+    for (auto _: state) {
+        SyntheticPayroll syntheticPayroll;
+        benchmark::DoNotOptimize(generateSyntheticWorkload(workload, syntheticPayroll.employeeRegistry, syntheticPayroll.paymentLedger, threadPool));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(benchmarkGenerateSyntheticWorkload)->ArgsProduct({{1000, 100000, 10000000}, {1, 4}})->Unit(benchmark::kMillisecond);
+
+// A new random employee's id
+void benchmarkGenerateEmployeeId(benchmark::State &state) {
+    for (auto _: state) benchmark::DoNotOptimize(generateEmployeeId());
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(benchmarkGenerateEmployeeId);
+
+// A given amount of new random employees' ids at once, from a single generator
+void benchmarkGenerateEmployeeIds(benchmark::State &state) {
+    vector<EmployeeId> employeeIds(static_cast<size_t>(state.range(0)));
+    mt19937_64 generator(SYNTHETIC_PAYROLL_SEED);
+    for (auto _: state) {
+        for (EmployeeId &employeeId: employeeIds) employeeId = generateEmployeeId(generator);
+        benchmark::DoNotOptimize(employeeIds.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(benchmarkGenerateEmployeeIds)->Apply(applyEmployeeScales)->Unit(benchmark::kMicrosecond);
+
+// The baseline of the one above: the same amount of ids, as the 36 characters strings they used to be
+void benchmarkGenerateUuidStrings(benchmark::State &state) {
+    vector<string> uuids(static_cast<size_t>(state.range(0)));
+    mt19937 generator(SYNTHETIC_PAYROLL_SEED);
+    for (auto _: state) {
+        for (string &uuid: uuids) uuid = generateUuidString(generator);
+        benchmark::DoNotOptimize(uuids.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(benchmarkGenerateUuidStrings)->Apply(applyEmployeeScales)->Unit(benchmark::kMicrosecond);
+
+// Looking up random employees by their ids, among the current ones (half of the ids exist, & half don't)
+void benchmarkFindEmployee(benchmark::State &state) {
+    const EmployeeRegistry employeeRegistry = createSyntheticEmployeeRegistry(static_cast<size_t>(state.range(0)));
+    mt19937_64 generator(SYNTHETIC_PAYROLL_SEED);
+    vector<EmployeeId> employeeIds(BENCHMARK_QUERIES_AMOUNT);
+    for (size_t query = 0; query < employeeIds.size(); query++) {
+        employeeIds[query] = query % 2 == 0 ? employeeRegistry.employees[generator() % employeeRegistry.size()].id : generateEmployeeId();
+    }
+
+    size_t query = 0;
+    for (auto _: state) benchmark::DoNotOptimize(existEmployee(employeeRegistry, employeeIds[query++ % BENCHMARK_QUERIES_AMOUNT]));
+    state.SetItemsProcessed(static_cast<int64_t>(query));
+}
+BENCHMARK(benchmarkFindEmployee)->Apply(applyEmployeeScales);
+
+// Deleting random current employees (swapping the last one into their place, & fixing its index). Each deleted employee gets inserted back untimed,
+// so the registry keeps its size along the whole benchmark
+void benchmarkDeleteEmployee(benchmark::State &state) {
+    EmployeeRegistry employeeRegistry = createSyntheticEmployeeRegistry(static_cast<size_t>(state.range(0)));
+    mt19937_64 generator(SYNTHETIC_PAYROLL_SEED);
+    for (auto _: state) {
+        Employee employee = employeeRegistry.employees[generator() % employeeRegistry.size()];
+        const auto start = chrono::steady_clock::now();
+        deleteEmployeById(employeeRegistry, employee.id);
+        state.SetIterationTime(chrono::duration<double>(chrono::steady_clock::now() - start).count());
+        insertEmployee(employeeRegistry, move(employee));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(benchmarkDeleteEmployee)->Apply(applyEmployeeScales)->UseManualTime();
+
+// An employee's id, as the text shown to the users
+void benchmarkFormatEmployeeId(benchmark::State &state) {
+    const EmployeeId employeeId = generateEmployeeId();
+    char employeeIdText[EMPLOYEE_ID_TEXT_LENGTH];
+    for (auto _: state) {
+        benchmark::DoNotOptimize(formatEmployeeId(employeeIdText, employeeId));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(benchmarkFormatEmployeeId);
+
+// An amount of money, as shown in the tables
+void benchmarkMonetizeDouble(benchmark::State &state) {
+    double amount = 1234567.891;
+    for (auto _: state) {
+        benchmark::DoNotOptimize(monetizeDouble(amount));
+        amount += 0.01;
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(benchmarkMonetizeDouble);
+
+// The baseline of the one above: the same amounts of money, through a stringstream & a few temporary strings
+void benchmarkMonetizeDoubleThroughStreams(benchmark::State &state) {
+    double amount = 1234567.891;
+    for (auto _: state) {
+        benchmark::DoNotOptimize(monetizeDoubleThroughStreams(amount));
+        amount += 0.01;
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(benchmarkMonetizeDoubleThroughStreams);
+
+// All the payments as a single page of the table of payments, through the table renderer (10M rows would take too long for the baseline below, so it stops at 100k)
+void benchmarkPrintPaymentsPage(benchmark::State &state) {
+    const PaymentLedger &paymentLedger = getSyntheticPayroll(static_cast<size_t>(state.range(0)), false).paymentLedger;
+    ConsoleOutputDiscarder consoleOutputDiscarder;
+    for (auto _: state) {
+        PaymentCursor paymentCursor = openPaymentCursor(paymentLedger, 0);
+        printPaymentsPage(paymentCursor);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(benchmarkPrintPaymentsPage)->Arg(1000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+// The baseline of the one above: the same table, field by field into the console (flushing every line), like before the table renderer
+void benchmarkPrintPaymentsThroughStreams(benchmark::State &state) {
+    const vector<Payment> &payments = getSyntheticPayments(static_cast<size_t>(state.range(0)));
+    ConsoleOutputDiscarder consoleOutputDiscarder;
+    for (auto _: state) printPaymentsThroughStreams(payments);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(benchmarkPrintPaymentsThroughStreams)->Arg(1000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+// A typed number, validated & parsed just like getDouble() does it
+void benchmarkParseNumber(benchmark::State &state) {
+    const string_view typedNumbers[] = {"25", "17.5", "-3", "1.5e3", "1x5", "30.25", "+12", "abc"};
+    double number;
+    size_t parse = 0;
+    for (auto _: state) benchmark::DoNotOptimize(parseNumber(typedNumbers[parse++ % size(typedNumbers)], number));
+    state.SetItemsProcessed(static_cast<int64_t>(parse));
+}
+BENCHMARK(benchmarkParseNumber);
+
+BENCHMARK_MAIN();
+
+
+/**
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                         *
+ *          CUSTOM MADE FUNCTIONS DEFINITIONS              *
+ *                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ **/
+
+// Gets the SyntheticWorkload with a given amount of payments (one employee per 50 of them), from a fixed seed, optionally with some overtime-exempt employees
+SyntheticWorkload createSyntheticWorkload(const size_t paymentsAmount, const bool withMixedPolicies) {
+    return SyntheticWorkload {.employeesAmount = max<size_t>(1, paymentsAmount / SYNTHETIC_PAYMENTS_PER_EMPLOYEE), .paymentsAmount = paymentsAmount, .seed = SYNTHETIC_PAYROLL_SEED,
+                              .overtimeExemptShare = withMixedPolicies ? GENERATED_OVERTIME_EXEMPT_SHARE : 0};
+}
+
+// Generates the SyntheticPayroll of a given amount of payments (& policies mix), from a fixed seed
+unique_ptr<SyntheticPayroll> generateSyntheticPayroll(const size_t paymentsAmount, const bool withMixedPolicies) {
+    auto syntheticPayroll = make_unique<SyntheticPayroll>();
+    ThreadPool threadPool(max(1u, thread::hardware_concurrency())); // The workload does not depend on the amount of threads
+    generateSyntheticWorkload(createSyntheticWorkload(paymentsAmount, withMixedPolicies), syntheticPayroll->employeeRegistry, syntheticPayroll->paymentLedger, threadPool);
+    return syntheticPayroll;
+}
+
+// Gets the SyntheticPayroll with a given amount of payments (& policies mix), generating it only the first time it's asked for
+const SyntheticPayroll &getSyntheticPayroll(const size_t paymentsAmount, const bool withMixedPolicies) {
+    static map<pair<size_t, bool>, unique_ptr<SyntheticPayroll>> syntheticPayrolls;
+    unique_ptr<SyntheticPayroll> &syntheticPayroll = syntheticPayrolls[{paymentsAmount, withMixedPolicies}];
+    if (!syntheticPayroll) syntheticPayroll = generateSyntheticPayroll(paymentsAmount, withMixedPolicies);
+    return *syntheticPayroll;
+}
+
+// Gets all the Payment structure variables of the SyntheticPayroll with a given amount of payments (standard policies only), gathering them only the first time it's asked for
+const vector<Payment> &getSyntheticPayments(const size_t paymentsAmount) {
+    static map<size_t, vector<Payment>> syntheticPayments;
+    vector<Payment> &payments = syntheticPayments[paymentsAmount];
+    if (payments.empty()) {
+        const PaymentLedger &paymentLedger = getSyntheticPayroll(paymentsAmount, false).paymentLedger;
+        payments.reserve(paymentLedger.size());
+        for (size_t position = 0; position < paymentLedger.size(); position++) payments.push_back(getPayment(paymentLedger, position));
+    }
+    return payments;
+}
+
+// Creates an EmployeeRegistry with a given amount of employees (& no payments at all), from a fixed seed
+EmployeeRegistry createSyntheticEmployeeRegistry(const size_t employeesAmount) {
+    EmployeeRegistry employeeRegistry;
+    mt19937_64 generator(SYNTHETIC_PAYROLL_SEED);
+    for (size_t i = 0; i < employeesAmount; i++) {
+        insertEmployee(employeeRegistry, Employee {.id = generateEmployeeId(generator), .firstName = "Synthetic", .lastName = "Employee " + to_string(i), .regRate = 25.0});
+    }
+    return employeeRegistry;
+}
+
+// Draws from a given generator one of the pay dates of a given PaymentLedger (which must have payments)
+int32_t drawPayDate(const PaymentLedger &paymentLedger, mt19937_64 &generator) {
+    const vector<int32_t> &payDates = paymentLedger.payDateIndex.payDates;
+    return payDates[generator() % payDates.size()];
+}
+
+// Draws from a given generator a new payment to one of the employees of a given SyntheticPayroll, in one of its pay dates, into the reference of a given Payment
+void drawPayment(const SyntheticPayroll &syntheticPayroll, mt19937_64 &generator, Payment &payment) {
+    const EmployeeRegistry &employeeRegistry = syntheticPayroll.employeeRegistry;
+    const Employee &employee = employeeRegistry.employees[generator() % employeeRegistry.size()];
+    payment.employeeId = employee.id;
+    payment.firstName = employee.firstName;
+    payment.lastName = employee.lastName;
+    payment.hoursWorked = static_cast<double>(1 + generator() % MAX_HOURS_WORKED);
+    payment.regRate = employee.regRate;
+    payment.payDate = drawPayDate(syntheticPayroll.paymentLedger, generator);
+    payment.payrollPolicy = employee.payrollPolicy;
+}
+
+// Sets the percentiles 50, 99 & 99.9 of some given latencies (in nanoseconds) as the counters of a given benchmark
+void setLatencyPercentiles(benchmark::State &state, vector<int64_t> &latencies) {
+    if (latencies.empty()) return;
+    const pair<const char *, double> percentiles[] = {{"p50_ns", 0.50}, {"p99_ns", 0.99}, {"p999_ns", 0.999}};
+    for (const auto &[name, fraction]: percentiles) {
+        const auto percentile = latencies.begin() + static_cast<ptrdiff_t>(fraction * static_cast<double>(latencies.size() - 1));
+        nth_element(latencies.begin(), percentile, latencies.end());
+        state.counters[name] = static_cast<double>(*percentile);
+    }
+}
+
+// Sets the amounts of payments of a benchmark: 1k, 100k & 10M
+void applyPaymentScales(benchmark::internal::Benchmark *aBenchmark) {
+    aBenchmark->Arg(1000)->Arg(100000)->Arg(10000000);
+}
+
+// Sets the amounts of employees of a benchmark: 10k, 100k & 1M
+void applyEmployeeScales(benchmark::internal::Benchmark *aBenchmark) {
+    aBenchmark->Arg(10000)->Arg(100000)->Arg(1000000);
+}
+
+// Sets the amounts of payments (1k, 100k & 10M) & of report workers (from 1 up to one per CPU core, doubling them) of a benchmark
+void applyReportWorkersScales(benchmark::internal::Benchmark *aBenchmark) {
+    const unsigned coresAmount = clamp(thread::hardware_concurrency(), 1u, MAX_REPORT_WORKERS);
+    for (const int64_t paymentsAmount: {1000, 100000, 10000000}) {
+        for (unsigned workersAmount = 1; workersAmount < coresAmount; workersAmount *= 2) aBenchmark->Args({paymentsAmount, workersAmount});
+        aBenchmark->Args({paymentsAmount, coresAmount}); // All the cores, even if it's not a power of 2
+    }
+}
+
+// Redirects the console into itself (so whatever gets written to it is discarded), in the fixed format with 2 decimals that the program's tables get printed with
+ConsoleOutputDiscarder::ConsoleOutputDiscarder() : consoleBuffer(cout.rdbuf(this)), consoleFlags(cout.flags()), consolePrecision(cout.precision()) {
+    cout << fixed << setprecision(2);
+}
+
+// Gives the console back its own buffer & format
+ConsoleOutputDiscarder::~ConsoleOutputDiscarder() {
+    cout.rdbuf(consoleBuffer);
+    cout.flags(consoleFlags);
+    cout.precision(consolePrecision);
+}
+
+// The baseline of the portable aggregation kernels, with the money as plain doubles (neither rounded to the cent, nor added up as integers), for the standard payroll policy
+void accumulateDoublePaymentColumnsScalar(const double *hoursWorked, const double *regRates, const size_t paymentsAmount, double (&lanes)[DOUBLE_KERNEL_FIELDS][KERNEL_LANES]) {
+    constexpr PayrollRules RULES = PAYROLL_RULES[STANDARD_PAYROLL_POLICY];
+    for (size_t i = 0; i < paymentsAmount; i++) {
+        const double regHours = hoursWorked[i] <= RULES.maxRegHours ? hoursWorked[i] : RULES.maxRegHours;
+        const double otHours = hoursWorked[i] <= RULES.maxRegHours ? 0 : hoursWorked[i] - RULES.maxRegHours;
+        const double regPay = regHours * regRates[i];
+        const double otPay = otHours * (regRates[i] * RULES.otMultiplier);
+        const double totalPay = regPay + otPay;
+        const size_t lane = i % KERNEL_LANES;
+        lanes[0][lane] += regHours;
+        lanes[1][lane] += otHours;
+        lanes[2][lane] += regPay;
+        lanes[3][lane] += otPay;
+        lanes[4][lane] += totalPay * RULES.ficaRate;
+        lanes[5][lane] += totalPay * RULES.ssMedRate;
+    }
+}
+
+#ifdef PAYROLL_HAS_AVX2_KERNELS
+// The baseline of the AVX2 aggregation kernels, with the money as plain doubles (neither rounded to the cent, nor added up as integers), for the standard payroll policy
+__attribute__((target("avx2"))) void accumulateDoublePaymentColumnsAvx2(const double *hoursWorked, const double *regRates, const size_t paymentsAmount,
+                                                                        double (&lanes)[DOUBLE_KERNEL_FIELDS][KERNEL_LANES]) {
+    constexpr PayrollRules RULES = PAYROLL_RULES[STANDARD_PAYROLL_POLICY];
+    const __m256d maxRegHours = _mm256_set1_pd(RULES.maxRegHours);
+    const __m256d otMultiplier = _mm256_set1_pd(RULES.otMultiplier);
+    const __m256d ficaRate = _mm256_set1_pd(RULES.ficaRate);
+    const __m256d ssMedRate = _mm256_set1_pd(RULES.ssMedRate);
+    const __m256d zero = _mm256_setzero_pd();
+    __m256d sums[DOUBLE_KERNEL_FIELDS];
+    for (int field = 0; field < DOUBLE_KERNEL_FIELDS; field++) sums[field] = _mm256_loadu_pd(lanes[field]);
+
+    const size_t vectorizedAmount = paymentsAmount - paymentsAmount % KERNEL_LANES;
+    for (size_t i = 0; i < vectorizedAmount; i += KERNEL_LANES) {
+        const __m256d hours = _mm256_loadu_pd(hoursWorked + i);
+        const __m256d rate = _mm256_loadu_pd(regRates + i);
+        const __m256d isRegularOnly = _mm256_cmp_pd(hours, maxRegHours, _CMP_LE_OQ);
+        const __m256d regHours = _mm256_blendv_pd(maxRegHours, hours, isRegularOnly);
+        const __m256d otHours = _mm256_blendv_pd(_mm256_sub_pd(hours, maxRegHours), zero, isRegularOnly);
+        const __m256d regPay = _mm256_mul_pd(regHours, rate);
+        const __m256d otPay = _mm256_mul_pd(otHours, _mm256_mul_pd(rate, otMultiplier));
+        const __m256d totalPay = _mm256_add_pd(regPay, otPay);
+        sums[0] = _mm256_add_pd(sums[0], regHours);
+        sums[1] = _mm256_add_pd(sums[1], otHours);
+        sums[2] = _mm256_add_pd(sums[2], regPay);
+        sums[3] = _mm256_add_pd(sums[3], otPay);
+        sums[4] = _mm256_add_pd(sums[4], _mm256_mul_pd(totalPay, ficaRate));
+        sums[5] = _mm256_add_pd(sums[5], _mm256_mul_pd(totalPay, ssMedRate));
+    }
+    for (int field = 0; field < DOUBLE_KERNEL_FIELDS; field++) _mm256_storeu_pd(lanes[field], sums[field]);
+
+    // The remaining payments (less than 4) go one by one to the very same lanes they would have occupied
+    accumulateDoublePaymentColumnsScalar(hoursWorked + vectorizedAmount, regRates + vectorizedAmount, paymentsAmount - vectorizedAmount, lanes);
+}
+#endif
+
+// The baseline of the portable aggregation kernels' payroll policies: the standard payroll policy's rules hard-coded (neither looked up nor dispatched), with the money
+// rounded to the cent & added up as integers just like them. The payroll policies of the payments (& whether they are mixed) get ignored
+void accumulateHardCodedPaymentColumnsScalar(const double *hoursWorked, const double *regRates, const PayrollPolicy *, const size_t paymentsAmount, bool, KernelLanes &lanes) {
+    for (size_t i = 0; i < paymentsAmount; i++) {
+        const double regHours = hoursWorked[i] <= MAX_REG_HOURS ? hoursWorked[i] : MAX_REG_HOURS;
+        const double otHours = hoursWorked[i] <= MAX_REG_HOURS ? 0 : hoursWorked[i] - MAX_REG_HOURS;
+        const Money regPay = Money::fromDollars(regHours * regRates[i]);
+        const Money otPay = Money::fromDollars(otHours * (regRates[i] * OT_MULT));
+        const Money totalPay = regPay + otPay;
+        const size_t lane = i % KERNEL_LANES;
+        lanes.hours[0][lane] += regHours;
+        lanes.hours[1][lane] += otHours;
+        lanes.cents[0][lane] += regPay.cents;
+        lanes.cents[1][lane] += otPay.cents;
+        lanes.cents[2][lane] += totalPay.times(FICA_RATE).cents;
+        lanes.cents[3][lane] += totalPay.times(SS_MED_RATE).cents;
+    }
+}
+
+// The baseline of generateEmployeeId(): a new random id as the 36 characters string it used to be, drawing each hexadecimal digit from a given generator on its own
+string generateUuidString(mt19937 &generator) {
+    uniform_int_distribution<int> distribution(0, 15); // The index of each one of the 16 possible characters
+    constexpr bool mustAddDashes[] = {false, false, false, false, true, false, true, false, true, false, true, false, false, false, false, false};
+    string generatedId;
+
+    const string allowedCharacters = "0123456789abcdef";
+    for (const bool mustAddDashNow: mustAddDashes) {
+        if (mustAddDashNow) generatedId += "-";
+        generatedId += allowedCharacters[distribution(generator)];
+        generatedId += allowedCharacters[distribution(generator)];
+    }
+
+    return generatedId;
+}
+
+// The baseline of monetizeDouble(): a given amount of money, formatted through a stringstream & a few temporary strings, like before the table renderer
+string monetizeDoubleThroughStreams(const double doubleValue) {
+    const auto integerValue = static_cast<unsigned long long int>(doubleValue);
+    string integerAsString = to_string(integerValue);
+    for (int j = static_cast<int>(integerAsString.length()) - 3; j > 0; j -= 3) integerAsString.insert(j, ",");
+
+    stringstream stream;
+    stream << fixed << setprecision(2) << doubleValue - static_cast<double>(integerValue);
+    const string decimalsAsString = stream.str(); // Still with the "0" before the dot (Ex: 0.34)
+    return string("$ ") + integerAsString + decimalsAsString.substr(1, 3);
+}
+
+// The baseline of printPaymentsPage(): prints a given vector of Payment structure variables as a table, field by field into the console (flushing every line), like before the table renderer
+void printPaymentsThroughStreams(const vector<Payment> &payments) {
+    int largestFullNameLength = FULL_NAME_TITLE_LENGTH;
+    for (const Payment &payment: payments) largestFullNameLength = max(largestFullNameLength, static_cast<int>(payment.firstName.size() + 1 + payment.lastName.size()));
+
+    cout << endl;
+
+    // Table Header
+    printLineUnderPaymentsTableRowThroughStreams(largestFullNameLength);
+    cout << "| Full Name ";
+    for (int i = FULL_NAME_TITLE_LENGTH; i < largestFullNameLength; i++) cout << " ";
+    cout << " |  Pay Date  | Hrs Worked | Reg Hrs | Reg Rate | OT Hrs | OT Rate |    Reg Pay   |    OT Pay    |  Total Pay   |     FICA     | Soc Security | Total Deduc. |    Net Pay   |" << endl;
+    printLineUnderPaymentsTableRowThroughStreams(largestFullNameLength);
+
+    // Each one of the rows
+    for (const Payment &payment: payments) {
+        int year, month, day;
+        civilDateFromDays(payment.payDate, year, month, day);
+        cout << "| " << left << setw(largestFullNameLength) << string(payment.firstName) + " " + string(payment.lastName) << right << " | ";
+        cout << setfill('0') << setw(4) << year << '-' << setw(2) << month << '-' << setw(2) << day << setfill(' ') << " | " << setw(10) << payment.hoursWorked << " | ";
+        cout << setw(7) << payment.regHours() << " | " << setw(8) << monetizeDoubleThroughStreams(payment.regRate) << " | " << setw(6) << payment.otHours() << " | ";
+        cout << setw(7) << monetizeDoubleThroughStreams(payment.otRate()) << " | " << setw(12) << monetizeDoubleThroughStreams(payment.regPay().dollars()) << " | ";
+        cout << setw(12) << monetizeDoubleThroughStreams(payment.otPay().dollars()) << " | " << setw(12) << monetizeDoubleThroughStreams(payment.totalPay().dollars()) << " | ";
+        cout << setw(12) << monetizeDoubleThroughStreams(payment.fica().dollars()) << " | " << setw(12) << monetizeDoubleThroughStreams(payment.socSec().dollars()) << " | ";
+        cout << setw(12) << monetizeDoubleThroughStreams(payment.totDeductions().dollars()) << " | " << setw(12) << monetizeDoubleThroughStreams(payment.netPay().dollars()) << " |" << endl;
+        printLineUnderPaymentsTableRowThroughStreams(largestFullNameLength);
+    }
+}
+
+// The baseline of renderLineUnderPaymentsTableRow(): prints the line under each row of the table of payments, dash by dash, for a given largest full name's length
+void printLineUnderPaymentsTableRowThroughStreams(const int largestFullNameLength) {
+    for (int i = 0; i < largestFullNameLength + 175; i++) cout << "-";
+    cout << endl;
+}
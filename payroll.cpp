@@ -0,0 +1,4097 @@
+/**
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                   *
+ *   Payroll Pro 2.0 - The payroll core                              *
+ *                                                                   *
+ *   Purpose:                                                        *
+ *   The definitions of every function prototyped in payroll.h.      *
+ *                                                                   *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ **/
+
+#include "payroll.h"
+
+// The ledger files get memory-mapped on POSIX systems (on Windows they just get read into memory, with the same layout)
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#else
+#include <io.h>
+#include <fcntl.h>
+#endif
+
+#ifdef PAYROLL_HAS_AVX2_KERNELS
+#include <immintrin.h>
+
+// Rounds 4 given amounts of cents to whole ones, with the very same saturation & rounding as Money::fromCents(), as 64-bit integers
+// (AVX2 has no conversion from doubles to 64-bit integers of its own). The rounded amounts also go, still as doubles, into the reference of a given register
+__attribute__((target("avx2"))) __m256i roundCentsAvx2(__m256d, __m256d &);
+
+// Rounds 4 given amounts of cents to whole ones, with the very same saturation & rounding as Money::fromCents(), as 64-bit integers
+__attribute__((target("avx2"))) __m256i roundCentsAvx2(__m256d);
+#endif
+
+using namespace std;
+
+
+/**
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                         *
+ *            UTILITY FUNCTIONS DEFINITIONS                *
+ *                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ **/
+
+
+// Prints a given value, of almost any kind, once in the terminal
+template<typename T>
+void print(const T &);
+
+// Prints a given value, of almost any kind, N given times in the terminal
+template<typename T>
+void printNTimes(const T &item, const int times) {
+    for (int i = 0; i < times; i++) {
+        print(item);
+    }
+}
+
+// Prints a given value, of almost any kind, N given times in the terminal, and then breaks the line
+template<typename T>
+void printNTimesAndBreak(const T &item, const int times) {
+    printNTimes(item, times);
+    printLine("");
+}
+
+// Prints a given value, of almost any kind, once in the terminal, and then breaks the line
+template<typename T>
+void printLine(const T &item) {
+    cout << item << endl;
+}
+
+// Determines if a given string is a valid floating point number (or integer), like 12, -3.5 or 1.5e3, in a single pass with no allocations
+bool isFloatingPoint(const string_view input) {
+    // The same grammar as ^[+-]?[0-9]+(\.[0-9]+)?([eE][+-]?[0-9]+)?$, lexed by hand: every part consumes its digits, & must have at least one
+    size_t position = 0;
+    const auto skipSign = [&]() { if (position < input.size() && (input[position] == '+' || input[position] == '-')) position++; };
+    const auto skipDigits = [&]() {
+        const size_t firstDigit = position;
+        while (position < input.size() && '0' <= input[position] && input[position] <= '9') position++;
+        return position > firstDigit;
+    };
+
+    skipSign();
+    if (!skipDigits()) return false;
+    if (position < input.size() && input[position] == '.') {
+        position++;
+        if (!skipDigits()) return false;
+    }
+    if (position < input.size() && (input[position] == 'e' || input[position] == 'E')) {
+        position++;
+        skipSign();
+        if (!skipDigits()) return false;
+    }
+    return position == input.size();
+}
+
+// Parses a given typed number (an integer or a floating point one, as isFloatingPoint() accepts them) into the reference of a given double.
+// Returns false if it's not such a number, or if it doesn't fit in a double
+bool parseNumber(string_view input, double &number) {
+    if (!isFloatingPoint(input)) return false;
+    if (input.front() == '+') input.remove_prefix(1); // from_chars doesn't accept a leading plus sign
+
+    const auto [end, errorCode] = from_chars(input.data(), input.data() + input.size(), number);
+    return errorCode == errc() && end == input.data() + input.size();
+}
+
+// Parses a given integer (an optional sign & just digits) into the reference of a given int. Returns false if it's not such an integer, or if it doesn't fit in an int
+bool parseInteger(string_view input, int &integer) {
+    const bool hasPlusSign = !input.empty() && input.front() == '+';
+    if (hasPlusSign) input.remove_prefix(1); // from_chars doesn't accept a leading plus sign
+    if (input.empty() || (hasPlusSign && input.front() == '-')) return false;
+
+    const auto [end, errorCode] = from_chars(input.data(), input.data() + input.size(), integer);
+    return errorCode == errc() && end == input.data() + input.size();
+}
+
+// Receives and validates a double number (or the equivalent of an integer) from the console
+double getDouble(const string &message, const double minValue, const double maxValue, const bool showRange, const string &errorMessage, const vector<double> &sentinelValues) {
+    string numberAsString; // Value typed by the user, that can be a valid (integer or floating point) number or not
+    double number = 0; // Double convertion (if possible) of the value typed by the user
+    bool keepAsking = true; // If we must keep asking for a value to the user, until receiving either an integer or a flating point number
+
+    do {
+        cout << fixed << setprecision(2) << message;
+        if (showRange)
+            cout << " (" << minValue << " - " << maxValue << ")";
+        cout << ": ";
+        getline(cin, numberAsString);
+
+        if (!parseNumber(numberAsString, number)) {
+            cout << "That's not an integer number nor a valid floating point number. Try again." << endl;
+            continue; // There is no point in keep validating any further, as it's not even a valid integer nor a floating point number
+        }
+
+        const bool invalidInput = number < minValue || maxValue < number; // If the input is valid, based only in minimum & maximum possible values
+        // If the typed number is not among the given sentinel values (breaking values)
+        const bool numberIsNotSentinel = count(sentinelValues.begin(), sentinelValues.end(), number) == 0;
+        keepAsking = invalidInput && numberIsNotSentinel;
+        if (keepAsking) cout << errorMessage << endl;
+    } while (keepAsking);
+
+    return number;
+}
+
+bool containsSingleChar(const string &input) {
+    return input.length() == 1;
+}
+
+char getAlphaChar(const string &message, const string &errorMessage) {
+    string characterAsString; // Value typed by the user, that can be a char or not
+    char character = 'A'; // Char convertion (if possible) of the value typed by the user
+    bool isNotAlphaCharacter = true; // If the character is alphabetic
+
+    do {
+        cout << message << ": ";
+        getline(cin, characterAsString);
+
+        if (!containsSingleChar(characterAsString)) {
+            cout << "That's not a single character. Try again." << endl;
+            continue; // There is no point in keep validating any further, as it's not even a valid char
+        }
+
+        // const char *characterPointer = characterAsString.data(); // Only valid on C++ 17 or newer
+        const char *characterPointer = characterAsString.c_str();
+        character = characterPointer[0];
+
+        isNotAlphaCharacter = !isalpha(character);
+        if (isNotAlphaCharacter) cout << errorMessage << endl;
+    } while (isNotAlphaCharacter);
+
+    return character;
+}
+
+// Gets a string with or without spaces, from the terminal, as a response of a given question
+string getStringFromMessage(const string &message) {
+    cout << message;
+    string value;
+    getline(cin, value);
+    return value;
+}
+
+// Formats a given positive int by inserting a comma every 3 digits of its equivalent string, to make it more readable, by US standards
+string humanizeUnsignedInteger(const unsigned long long int integerValue) {
+    char buffer[FORMATTED_NUMBER_CAPACITY]; // The only string allocated is the returned one
+    return string(buffer, formatGroupedInteger(buffer, buffer + sizeof(buffer), integerValue));
+}
+
+// Formats a given positive double by inserting a comma every 3 digits of its equivalent string, to make it more readable, by US standards
+string humanizeUnsignedDouble(const double doubleValue, const int precision) {
+    char buffer[FORMATTED_NUMBER_CAPACITY];
+    return string(buffer, formatGroupedFixed(buffer, buffer + sizeof(buffer), doubleValue, precision));
+}
+
+// Formats a given double by inserting a comma every 3 digits of its equivalent string, to make it more readable, and adds a customizable currency symbol
+string monetizeDouble(const double doubleValue, const int precision, const bool prepend, const string &symbol) {
+    char buffer[FORMATTED_NUMBER_CAPACITY];
+    if (char *end = formatMoney(buffer, buffer + sizeof(buffer), doubleValue, precision, prepend, symbol)) return string(buffer, end);
+
+    // Only a really long currency symbol would not fit
+    string money(FORMATTED_NUMBER_CAPACITY + symbol.size(), ' ');
+    money.resize(formatMoney(money.data(), money.data() + money.size(), doubleValue, precision, prepend, symbol) - money.data());
+    return money;
+}
+
+// Writes a given unsigned integer into a given buffer (from its first to its last character), inserting a comma every 3 digits. Returns where it ended (nullptr if it does not fit)
+char *formatGroupedInteger(char *first, char *last, const unsigned long long int integerValue) {
+    char digits[24]; // Enough for any unsigned long long int
+    const char *const digitsEnd = to_chars(digits, digits + sizeof(digits), integerValue).ptr;
+    return groupIntegerDigits(first, last, digits, digitsEnd);
+}
+
+// Writes a given double into a given buffer, rounded as a whole to a given amount of decimals, with a comma every 3 digits of its integer part. Returns where it ended (nullptr if it does not fit)
+char *formatGroupedFixed(char *first, char *last, const double doubleValue, const int precision) {
+    // The whole number gets rounded at once (so 1.996 becomes 2.00, & never 1.00 as when the decimals got rounded apart from the integer part)
+    char digits[FORMATTED_NUMBER_CAPACITY];
+    const auto [digitsEnd, errorCode] = to_chars(digits, digits + sizeof(digits), doubleValue, chars_format::fixed, precision);
+    if (errorCode != errc()) return nullptr;
+    return groupIntegerDigits(first, last, digits, digitsEnd);
+}
+
+// Writes a given amount of money into a given buffer, grouped & rounded just like formatGroupedFixed(), with a currency symbol before or after it. Returns where it ended (nullptr if it does not fit)
+char *formatMoney(char *first, char *last, const double amount, const int precision, const bool prepend, const string_view symbol) {
+    if (static_cast<size_t>(last - first) < symbol.size() + 1) return nullptr;
+    if (prepend) {
+        first = copy(symbol.begin(), symbol.end(), first);
+        *first++ = ' ';
+    }
+
+    first = formatGroupedFixed(first, last, amount, precision);
+    if (first == nullptr || prepend) return first;
+
+    if (static_cast<size_t>(last - first) < symbol.size() + 1) return nullptr;
+    *first++ = ' ';
+    return copy(symbol.begin(), symbol.end(), first);
+}
+
+// Copies the characters of a given number into a given buffer, inserting a comma every 3 digits of its integer part. Returns where it ended (nullptr if it does not fit)
+char *groupIntegerDigits(char *first, char *last, const char *digits, const char *digitsEnd) {
+    const char *const integerStart = digits + (digits < digitsEnd && *digits == '-'); // The sign stays out of the groups
+    const char *const integerEnd = find(integerStart, digitsEnd, '.');
+    const size_t integerLength = integerEnd - integerStart;
+    const size_t commasAmount = integerLength > 0 ? (integerLength - 1) / 3 : 0;
+    if (static_cast<size_t>(last - first) < static_cast<size_t>(digitsEnd - digits) + commasAmount) return nullptr;
+
+    first = copy(digits, integerStart, first);
+    for (const char *digit = integerStart; digit < integerEnd; digit++) {
+        if (digit != integerStart && (integerEnd - digit) % 3 == 0) *first++ = ',';
+        *first++ = *digit;
+    }
+    return copy(integerEnd, digitsEnd, first); // The decimals, as they are
+}
+
+// Gets the days elapsed since 1970-01-01 until a given year, month & day of the (proleptic) Gregorian calendar (negative for the dates before it)
+int32_t daysFromCivilDate(const int year, const int month, const int day) {
+    // The years get counted from March, so the leap day is the very last one of each year, & the 400 years cycles (eras) repeat exactly
+    const int shiftedYear = month <= 2 ? year - 1 : year;
+    const int era = (shiftedYear >= 0 ? shiftedYear : shiftedYear - 399) / 400;
+    const int yearOfEra = shiftedYear - era * 400; // [0, 399]
+    const int dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1; // [0, 365]
+    const int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear; // [0, 146096]
+    return era * 146097 + dayOfEra - 719468; // 719468 days go from 0000-03-01 to 1970-01-01
+}
+
+// Gets the year, month & day of the (proleptic) Gregorian calendar, into the given references, of a given amount of days elapsed since 1970-01-01
+void civilDateFromDays(const int32_t days, int &year, int &month, int &day) {
+    // The inverse of daysFromCivilDate(), through the very same March based eras
+    const int shiftedDays = days + 719468;
+    const int era = (shiftedDays >= 0 ? shiftedDays : shiftedDays - 146096) / 146097;
+    const int dayOfEra = shiftedDays - era * 146097; // [0, 146096]
+    const int yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365; // [0, 399]
+    const int dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100); // [0, 365]
+    const int shiftedMonth = (5 * dayOfYear + 2) / 153; // [0, 11], from March
+    day = dayOfYear - (153 * shiftedMonth + 2) / 5 + 1;
+    month = shiftedMonth < 10 ? shiftedMonth + 3 : shiftedMonth - 9;
+    year = yearOfEra + era * 400 + (month <= 2);
+}
+
+// Reads a given date in the ISO 8601 format (YYYY-MM-DD, with a year between 0001 & 9999) into the reference of some given days since 1970-01-01. Returns false if it's not a valid date
+bool parseIsoDate(const string_view text, int32_t &days) {
+    if (text.size() != ISO_DATE_TEXT_LENGTH || text[4] != '-' || text[7] != '-') return false;
+
+    // Reads the digits of a given part of the text (all of them must be digits)
+    const auto readNumber = [&](const size_t first, const size_t length, int &number) {
+        const char *const end = text.data() + first + length;
+        const auto [pointer, errorCode] = from_chars(text.data() + first, end, number);
+        return errorCode == errc() && pointer == end && isdigit(static_cast<unsigned char>(text[first]));
+    };
+    int year, month, day;
+    if (!readNumber(0, 4, year) || !readNumber(5, 2, month) || !readNumber(8, 2, day) || year < 1 || month < 1 || 12 < month || day < 1) return false;
+
+    // Any day beyond the month's last one (like 2023-02-29) turns into another date when it gets back from the days
+    days = daysFromCivilDate(year, month, day);
+    int checkedYear, checkedMonth, checkedDay;
+    civilDateFromDays(days, checkedYear, checkedMonth, checkedDay);
+    return checkedYear == year && checkedMonth == month && checkedDay == day;
+}
+
+// Writes a given date (as days since 1970-01-01) into a given buffer, in the ISO 8601 format (YYYY-MM-DD). Returns where it ended
+char *formatIsoDate(char *first, const int32_t days) {
+    int year, month, day;
+    civilDateFromDays(days, year, month, day);
+    for (const int divisor: {1000, 100, 10, 1}) *first++ = static_cast<char>('0' + year / divisor % 10);
+    *first++ = '-';
+    *first++ = static_cast<char>('0' + month / 10);
+    *first++ = static_cast<char>('0' + month % 10);
+    *first++ = '-';
+    *first++ = static_cast<char>('0' + day / 10);
+    *first++ = static_cast<char>('0' + day % 10);
+    return first;
+}
+
+// Formats a given date (as days since 1970-01-01) in the ISO 8601 format (YYYY-MM-DD)
+string isoDateToString(const int32_t days) {
+    char dateText[ISO_DATE_TEXT_LENGTH];
+    return string(dateText, formatIsoDate(dateText, days));
+}
+
+// Gets today's (local) date, as days since 1970-01-01
+int32_t getTodaysDate() {
+    const time_t now = time(nullptr);
+    const tm localNow = *localtime(&now);
+    return daysFromCivilDate(localNow.tm_year + 1900, localNow.tm_mon + 1, localNow.tm_mday);
+}
+
+// Receives and validates a date in the ISO 8601 format (YYYY-MM-DD) from the console, as days since 1970-01-01
+int32_t getIsoDate(const string &message) {
+    string dateAsString; // Value typed by the user, that can be a valid date or not
+    int32_t days = 0; // The date typed by the user (once valid), as days since 1970-01-01
+    bool isInvalidDate;
+
+    do {
+        cout << message << " (YYYY-MM-DD): ";
+        getline(cin, dateAsString);
+
+        isInvalidDate = !parseIsoDate(dateAsString, days);
+        if (isInvalidDate) cout << "That's not a valid date, like " << isoDateToString(getTodaysDate()) << ". Try again." << endl;
+    } while (isInvalidDate);
+
+    return days;
+}
+
+// Reads the program's options from the command line arguments. Exits the program (showing its usage) if any of them is not valid
+ProgramOptions parseProgramOptions(const int argc, char *argv[]) {
+    ProgramOptions programOptions;
+
+    // Shows how to run the program, & exits with an error
+    const auto exitShowingUsage = [&]() {
+        cerr << "Usage: " << argv[0] << " [--report-workers N] [--ledger PATH] [--ledger-report] [--group-commit-records N] [--group-commit-latency-ms MS] [--log-compaction-records N] [--import-employees CSV] [--import-payments CSV] [--page-size N] [--headless] [--simulate CSV] [--generate EMPLOYEES PAYMENTS] [--seed N] [--stats-json PATH]" << endl;
+        cerr << "  --report-workers N   Threads used to build the reports that traverse payments (default 1, 0 means one per CPU core, " << MAX_REPORT_WORKERS << " at most)" << endl;
+        cerr << "  --ledger PATH        Ledger file loaded at the start & saved at the end (default " << DEFAULT_LEDGER_FILE_PATH << ")" << endl;
+        cerr << "  --ledger-report      Just prints the company's Payroll Reports straight from the ledger file, & exits" << endl;
+        cerr << "  --group-commit-records N      Changes synced to disk together at most (default " << DEFAULT_GROUP_COMMIT_RECORDS << ")" << endl;
+        cerr << "  --group-commit-latency-ms MS  The longest a change waits to be synced to disk (default " << DEFAULT_GROUP_COMMIT_LATENCY_MS << ", 0 means right away)" << endl;
+        cerr << "  --log-compaction-records N    Changes in the write-ahead log that get it folded into the ledger file (default " << DEFAULT_LOG_COMPACTION_RECORDS << ", or half the" << endl;
+        cerr << "                                ledger file's records if more; 0 means only when quitting)" << endl;
+        cerr << "  --import-employees CSV        Imports the employees of a CSV file (id,first_name,last_name,reg_rate[,payroll_policy]; the id is a UUID, & an empty one gets a new one;" << endl;
+        cerr << "                                the payroll policy is standard or overtime-exempt, & standard if missing), saves them, & exits" << endl;
+        cerr << "  --import-payments CSV         Imports the payments of a CSV file (employee_id,hours_worked[,pay_date]; the pay date is YYYY-MM-DD, & today's if missing), saves them, & exits" << endl;
+        cerr << "  --page-size N                 Payments shown at once by the \"all the payments\" option (default " << DEFAULT_PAYMENTS_PAGE_SIZE << ", 0 means all of them)" << endl;
+        cerr << "  --headless                    Runs the commands of the standard input, one per line (add-employee FIRST LAST RATE [POLICY], delete-employee ID," << endl;
+        cerr << "                                add-payment ID HOURS [PAY_DATE], report-company, report-employee ID, report-pay-dates FIRST LAST," << endl;
+        cerr << "                                report-quarter YEAR QUARTER, report-year-to-date [DATE]), writing a JSON line per result (dates are YYYY-MM-DD)" << endl;
+        cerr << "  --simulate CSV                Simulates the company's Payroll Report under the what-if scenarios of a CSV file (name,max_reg_hours,ot_multiplier,fica_rate," << endl;
+        cerr << "                                ss_med_rate; an empty rule keeps the current one, & the rates are fractions like 0.22), prints a comparison table per scenario, & exits" << endl;
+        cerr << "  --generate EMPLOYEES PAYMENTS Generates a synthetic workload of that many employees (at least 1) & payments, with realistic distributions (wage rates," << endl;
+        cerr << "                                overtime, churn & a few employees getting most of the payments), saves it along with whatever was loaded, & exits" << endl;
+        cerr << "  --seed N                      The seed of the generated workload (default " << DEFAULT_WORKLOAD_SEED << "; the same seed over the same ledger always generates the same workload)" << endl;
+        cerr << "  --stats-json PATH             Writes the instrumentation's statistics as JSON when the program ends (only in builds with PAYROLL_INSTRUMENTATION," << endl;
+        cerr << "                                which always print them as a table on the standard error)" << endl;
+        exit(1);
+    };
+
+    int integerValue; // The value of the last integer argument parsed
+    for (int i = 1; i < argc; i++) {
+        const string argument = argv[i];
+        const bool isFollowedByNaturalNumber = i + 1 < argc && parseInteger(argv[i + 1], integerValue) && integerValue >= 0; // Zero included
+        if (argument == "--report-workers" && isFollowedByNaturalNumber && static_cast<unsigned>(integerValue) <= MAX_REPORT_WORKERS) {
+            programOptions.reportWorkers = integerValue > 0 ? integerValue : clamp(thread::hardware_concurrency(), 1u, MAX_REPORT_WORKERS);
+            i++;
+        } else if (argument == "--ledger" && i + 1 < argc) {
+            programOptions.ledgerFilePath = argv[++i];
+        } else if (argument == "--ledger-report") {
+            programOptions.onlyPrintLedgerReport = true;
+        } else if (argument == "--group-commit-records" && isFollowedByNaturalNumber && integerValue >= 1) {
+            programOptions.groupCommitRecords = integerValue;
+            i++;
+        } else if (argument == "--group-commit-latency-ms" && isFollowedByNaturalNumber) {
+            programOptions.groupCommitLatencyMs = integerValue;
+            i++;
+        } else if (argument == "--log-compaction-records" && isFollowedByNaturalNumber) {
+            programOptions.logCompactionRecords = integerValue;
+            i++;
+        } else if (argument == "--import-employees" && i + 1 < argc) {
+            programOptions.employeesCsvPath = argv[++i];
+        } else if (argument == "--import-payments" && i + 1 < argc) {
+            programOptions.paymentsCsvPath = argv[++i];
+        } else if (argument == "--page-size" && isFollowedByNaturalNumber) {
+            programOptions.paymentsPageSize = integerValue;
+            i++;
+        } else if (argument == "--headless") {
+            programOptions.isHeadless = true;
+        } else if (argument == "--simulate" && i + 1 < argc) {
+            programOptions.scenariosCsvPath = argv[++i];
+        } else if (argument == "--generate" && isFollowedByNaturalNumber && integerValue >= 1 && i + 2 < argc) {
+            programOptions.syntheticWorkload.employeesAmount = integerValue;
+            if (!parseInteger(argv[i + 2], integerValue) || integerValue < 0) exitShowingUsage();
+            programOptions.syntheticWorkload.paymentsAmount = integerValue;
+            i += 2;
+        } else if (argument == "--seed" && isFollowedByNaturalNumber) {
+            programOptions.syntheticWorkload.seed = integerValue;
+            i++;
+        } else if (argument == "--stats-json" && i + 1 < argc) {
+            programOptions.instrumentationJsonPath = argv[++i];
+        } else {
+            exitShowingUsage();
+        }
+    }
+
+    return programOptions;
+}
+
+
+/**
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                         *
+ *          CUSTOM MADE FUNCTIONS DEFINITIONS              *
+ *                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ **/
+
+
+// Shows the program's welcoming message
+void showProgramWelcome() {
+    cout << endl;
+    cout << "* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *" << endl;
+    cout << "*                                                               *" << endl;
+    cout << "*                Welcome to Payroll Pro 2.0                     *" << endl;
+    cout << "*                                                               *" << endl;
+    cout << "* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *" << endl;
+}
+
+// Displays the menu to the user
+void displayMenu(const bool hasEmployees, const bool hasPayments) {
+    cout << endl;
+    cout << "-----------------------------------------------------------------" << endl;
+    cout << "                     P R O G R A M   M E N U                     " << endl;
+    cout << "-----------------------------------------------------------------" << endl;
+
+    cout << ADD_EMPLOYEE_OPTION << " - Input an Employee into the system." << endl;
+
+    if (hasEmployees) {
+        cout << DELETE_EMPLOYEE_OPTION << " - Delete an Employee from our system." << endl;
+        cout << SHOW_CURRENT_EMPLOYEES_OPTION << " - Show all the current/hired employees in our system." << endl;
+        cout << ADD_PAYMENT_OPTION << " - Input a Payment for an existing Employee." << endl;
+    }
+
+    if (hasEmployees && hasPayments) {
+        cout << GENERATE_AND_PRINT_CURRENT_EPR_OPTION << " - Print the Addition & Average Payroll Report only for a current & specific employee." << endl;
+    }
+
+    if (hasPayments) {
+        cout << SHOW_ALL_THE_PAYMENTS_OPTION << " - Show all the payments made by the company, even to ex employees" << endl;
+        cout << GENERATE_AND_PRINT_COMPANY_PR_OPTION << " - Print the Addition & Average Payroll Report for all the company's employees." << endl;
+        cout << GENERATE_AND_PRINT_ALL_EPR_OPTION << " - Print the Addition & Average Payroll Reports of every employee at once, even ex employees." << endl;
+        cout << GENERATE_AND_PRINT_PAY_DATES_PR_OPTION << " - Print the Addition & Average Payroll Report of the company for a range of pay dates, a quarter or the year to date." << endl;
+    }
+
+    cout << QUITTING_OPTION << " - Exit the Program." << endl;
+
+    cout << endl;
+}
+
+// Validates and returns if the given selection is among the allowed selections from the Menu
+bool isValidMenuSelection(const char input, const vector<char> &allowedAnswers) {
+    return count(allowedAnswers.begin(), allowedAnswers.end(), input) > 0;
+}
+
+// Gets the option selected by the user, from the menu's options
+char getMenuSelection(const bool hasEmployees, const bool hasPayments) {
+    char selection = ADD_EMPLOYEE_OPTION;
+    bool isInvalidAnswer;
+
+    // We dinamically fill/conform the allowed menu options to choose from, depending of the existence or not of at least one employee & if we have at least one payment
+    vector<char> allowedMenuOptions {ADD_EMPLOYEE_OPTION};
+    const vector<char> ifHasEmployeesOptions {DELETE_EMPLOYEE_OPTION, SHOW_CURRENT_EMPLOYEES_OPTION, ADD_PAYMENT_OPTION};
+    const vector<char> ifHasEmployeesAndPaymentsOptions {GENERATE_AND_PRINT_CURRENT_EPR_OPTION};
+    const vector<char> ifHasPaymentsOptions {SHOW_ALL_THE_PAYMENTS_OPTION, GENERATE_AND_PRINT_COMPANY_PR_OPTION, GENERATE_AND_PRINT_ALL_EPR_OPTION, GENERATE_AND_PRINT_PAY_DATES_PR_OPTION};
+    const vector<char> noMatterWhatAndLastOptions {QUITTING_OPTION}; // Done this way so the validation message with the available options gets shown ordered alphabetically
+
+    if (hasEmployees) allowedMenuOptions.insert(allowedMenuOptions.end(), ifHasEmployeesOptions.begin(), ifHasEmployeesOptions.end());
+    if (hasEmployees && hasPayments) allowedMenuOptions.insert(allowedMenuOptions.end(), ifHasEmployeesAndPaymentsOptions.begin(), ifHasEmployeesAndPaymentsOptions.end());
+    if (hasPayments) allowedMenuOptions.insert(allowedMenuOptions.end(), ifHasPaymentsOptions.begin(), ifHasPaymentsOptions.end());
+    allowedMenuOptions.insert(allowedMenuOptions.end(), noMatterWhatAndLastOptions.begin(), noMatterWhatAndLastOptions.end());
+
+    do {
+        selection = static_cast<char>(toupper(getAlphaChar("Type your selection please"))); // Typecasting to avoid a warning
+
+        isInvalidAnswer = !isValidMenuSelection(selection, allowedMenuOptions);
+        if (isInvalidAnswer) {
+            cout << "The only available options are: " << endl;
+            const size_t size = allowedMenuOptions.size();
+            for (int i = 0; i < size; i++) {
+                cout << allowedMenuOptions[i];
+                cout << (i == size - 2 ? ", or " : i == size - 1 ? "" : ", ");
+            }
+            cout << ". Try again." << endl;
+        }
+    } while (isInvalidAnswer);
+
+    return selection;
+}
+
+// Processes the selection made by the user from the menu
+void processMenuSelection(const char menuSelection, const ProgramOptions &programOptions, EmployeeRegistry &employeeRegistry, PaymentLedger &paymentLedger, ThreadPool &reportThreadPool, WriteAheadLog &writeAheadLog) {
+    switch (menuSelection) {
+        // Each branch gets timed as a whole (the time the user takes to answer included)
+        case ADD_EMPLOYEE_OPTION: {
+            PAYROLL_TIME_OPERATION(ADD_EMPLOYEE_OPERATION);
+            addEmployee(employeeRegistry, writeAheadLog);
+            break;
+        }
+        case DELETE_EMPLOYEE_OPTION: {
+            PAYROLL_TIME_OPERATION(DELETE_EMPLOYEE_OPERATION);
+            deleteCurrentEmployee(employeeRegistry, writeAheadLog);
+            break;
+        }
+        case SHOW_CURRENT_EMPLOYEES_OPTION: {
+            PAYROLL_TIME_OPERATION(SHOW_CURRENT_EMPLOYEES_OPERATION);
+            showCurrentEmployeesTable(employeeRegistry);
+            break;
+        }
+        case ADD_PAYMENT_OPTION: {
+            PAYROLL_TIME_OPERATION(ADD_PAYMENT_OPERATION);
+            addPayment(paymentLedger, employeeRegistry, writeAheadLog);
+            break;
+        }
+        case SHOW_ALL_THE_PAYMENTS_OPTION: {
+            PAYROLL_TIME_OPERATION(SHOW_ALL_THE_PAYMENTS_OPERATION);
+            printAllThePayments(paymentLedger, programOptions.paymentsPageSize);
+            break;
+        }
+        case GENERATE_AND_PRINT_CURRENT_EPR_OPTION: {
+            PAYROLL_TIME_OPERATION(CURRENT_EPR_OPERATION);
+            generateAndPrintCurrentEmployeePayrollReports(paymentLedger, employeeRegistry, reportThreadPool);
+            break;
+        }
+        case GENERATE_AND_PRINT_COMPANY_PR_OPTION: {
+            PAYROLL_TIME_OPERATION(COMPANY_PR_OPERATION);
+            generateAndPrintCompanyPayrollReports(paymentLedger);
+            break;
+        }
+        case GENERATE_AND_PRINT_ALL_EPR_OPTION: {
+            PAYROLL_TIME_OPERATION(ALL_EPR_OPERATION);
+            generateAndPrintAllEmployeesPayrollReports(paymentLedger);
+            break;
+        }
+        case GENERATE_AND_PRINT_PAY_DATES_PR_OPTION: {
+            PAYROLL_TIME_OPERATION(PAY_DATES_PR_OPERATION);
+            generateAndPrintPayDatesPayrollReports(paymentLedger);
+            break;
+        }
+        case QUITTING_OPTION:
+            sayGoodbyeToTheUser();
+            break;
+        default: ;
+    }
+}
+
+// Gets the length of the pargest full name among the current employees of a given EmployeeRegistry (0 if there are none)
+int getLargestFullNameLength(const EmployeeRegistry &employeeRegistry) {
+    if (employeeRegistry.empty()) return 0;
+
+    // Finds the largest full name's length among the employees using max_element
+    const auto largestEmployeeFullNameFirstIterator = max_element(employeeRegistry.employees.begin(), employeeRegistry.employees.end(),
+                                                                  [](const Employee &a, const Employee &b) {
+                                                                      return a.fullNameLength() < b.fullNameLength(); // No full name gets built just to be measured
+                                                                  });
+    return static_cast<int>(largestEmployeeFullNameFirstIterator->fullNameLength()); // Typecasting from size_t to int, just to avoid a warning
+}
+
+// Gets the length of the pargest full name among the employees that have received the payments of some given PaymentColumns
+int getLargestFullNameLength(const PaymentColumns &columns) {
+    // It gets maintained every time an employee enters the dictionary, so there is nothing to scan
+    return static_cast<int>(columns.largestFullNameLength); // Typecasting from size_t to int, just to avoid a warning
+}
+
+void showEmployeesTable(const EmployeeRegistry &employeeRegistry) {
+    PAYROLL_TIME_OPERATION(PRINT_EMPLOYEES_TABLE_OPERATION);
+    cout << endl;
+    cout << "Ok, these are the current employees:" << endl;
+    cout << endl;
+
+    // Finds the length of the employee with the largest full name (the column is never narrower than its title, though)
+    const int largestFullNameLength = max(FULL_NAME_TITLE_LENGTH, getLargestFullNameLength(employeeRegistry));
+
+    // The line under each row is always the same, so it gets built only once
+    TableRenderer tableRenderer(cout);
+    const string lineUnderRow = renderLineUnderEmployeesTableRow(largestFullNameLength);
+
+    // Table Header
+    tableRenderer.appendText(lineUnderRow);
+    tableRenderer.appendText("|                Unique ID             | Full Name ");
+    tableRenderer.appendPadding(largestFullNameLength - FULL_NAME_TITLE_LENGTH);
+    tableRenderer.appendText(" | Payroll Policy  |");
+    tableRenderer.endLine();
+    tableRenderer.appendText(lineUnderRow);
+
+    // Each one of the rows
+    for (const Employee &employee: employeeRegistry.employees) {
+        tableRenderer.appendText("| ");
+        tableRenderer.appendEmployeeId(employee.id);
+        tableRenderer.appendText(" | ");
+        tableRenderer.appendText(employee.firstName);
+        tableRenderer.appendText(" ");
+        tableRenderer.appendText(employee.lastName);
+        tableRenderer.appendPadding(largestFullNameLength - static_cast<int>(employee.fullNameLength()));
+        tableRenderer.appendText(" | ");
+        const string_view payrollPolicyName = PAYROLL_RULES[employee.payrollPolicy].name;
+        tableRenderer.appendText(payrollPolicyName);
+        tableRenderer.appendPadding(15 - static_cast<int>(payrollPolicyName.size()));
+        tableRenderer.appendText(" |");
+        tableRenderer.endLine();
+        tableRenderer.appendText(lineUnderRow);
+    }
+}
+
+// Renders an appropiate length "line" conformed by dashes (& its line break), as part of a good looking Employees table
+string renderLineUnderEmployeesTableRow(const int largestFullNameLength) {
+    return "-----------------------------------------" + string(max(0, largestFullNameLength), '-') + "--------------------\n";
+}
+
+// Adds an Employee structure variable to the reference of a given EmployeeRegistry
+void addEmployee(EmployeeRegistry &employeeRegistry, WriteAheadLog &writeAheadLog) {
+    cout << endl;
+    cout << "-----------------------------------------------------------------" << endl;
+    cout << "                  A D D I N G   E M P L O Y E E                  " << endl;
+    cout << "-----------------------------------------------------------------" << endl;
+    const string firstName = getStringFromMessage("Please type the first name of the new Employee: ");
+    const string lastName = getStringFromMessage("Please type the last name of the new Employee: ");
+    const double regRate = getDouble("Please type the regular payment rate of the new Employee", MIN_HOURLY_WAGE, MAX_HOURLY_WAGE, true);
+
+    constexpr char STANDARD_POLICY_OPTION = 'S';
+    constexpr char OVERTIME_EXEMPT_POLICY_OPTION = 'O';
+    char policySelection;
+    do {
+        policySelection = static_cast<char>(toupper(getAlphaChar("Is the new Employee paid by the (S)tandard payroll policy, or is (O)vertime-exempt")));
+        if (policySelection != STANDARD_POLICY_OPTION && policySelection != OVERTIME_EXEMPT_POLICY_OPTION)
+            cout << "The only available options are: " << STANDARD_POLICY_OPTION << ", or " << OVERTIME_EXEMPT_POLICY_OPTION << ". Try again." << endl;
+    } while (policySelection != STANDARD_POLICY_OPTION && policySelection != OVERTIME_EXEMPT_POLICY_OPTION);
+
+    Employee employee {.id = generateEmployeeId(), .firstName = firstName, .lastName = lastName, .regRate = regRate,
+                       .payrollPolicy = policySelection == OVERTIME_EXEMPT_POLICY_OPTION ? OVERTIME_EXEMPT_PAYROLL_POLICY : STANDARD_PAYROLL_POLICY};
+    logEmployeeAddition(writeAheadLog, employee); // Recorded first, so it survives even a crash right after
+    insertEmployee(employeeRegistry, move(employee));
+}
+
+// Removes an Employee structure variable from the reference of a given EmployeeRegistry, by its given id
+void deleteCurrentEmployee(EmployeeRegistry &employeeRegistry, WriteAheadLog &writeAheadLog) {
+
+    cout << endl;
+    cout << "-----------------------------------------------------------------" << endl;
+    cout << "                D E L E T I N G   E M P L O Y E E                " << endl;
+    cout << "-----------------------------------------------------------------" << endl;
+
+    // First we show the current employee's table to the user, so that the user can decide which employee to delete
+    showEmployeesTable(employeeRegistry);
+
+    const EmployeeId employeeId = getCurrentEmployeeIdFromMessage(employeeRegistry, "And now I need you to either type or copy/paste the id of the employee that you want to delete: "); // We are not leaving until we get an existing employee's id
+
+    // Once we know that an Employee exist with such id, then we can safely delete it (recording it first)
+    logEmployeeDeletion(writeAheadLog, employeeId);
+    deleteEmployeById(employeeRegistry, employeeId);
+}
+
+// Shows the table with all the current employees
+void showCurrentEmployeesTable(const EmployeeRegistry &employeeRegistry) {
+    cout << endl;
+    cout << "-----------------------------------------------------------------" << endl;
+    cout << "                C U R R E N T   E M P L O Y E E S                " << endl;
+    cout << "-----------------------------------------------------------------" << endl;
+
+    // First we show the employee's table to the user, so that the user can decide which employee to associate the new payment with
+    showEmployeesTable(employeeRegistry);
+}
+
+// Adds a Payment structure variable, associated to a specific Employee, to the reference of a given PaymentLedger
+void addPayment(PaymentLedger &paymentLedger, const EmployeeRegistry &employeeRegistry, WriteAheadLog &writeAheadLog) {
+
+    cout << endl;
+    cout << "-----------------------------------------------------------------" << endl;
+    cout << "                   A D D I N G   P A Y M E N T                   " << endl;
+    cout << "-----------------------------------------------------------------" << endl;
+
+    // First we show the employee's table to the user, so that the user can decide which employee to associate the new payment with
+    showEmployeesTable(employeeRegistry);
+
+    const EmployeeId employeeId = getCurrentEmployeeIdFromMessage(employeeRegistry, "And now I need you to either type or copy/paste the id of the employee to whom you are going to associate the payment: "); // We are not leaving until we get an existing employee's id
+
+    // Once we know that an Employee exist with such id, then we can safely retrieve it
+    const Employee &theEmployee = getEmployeById(employeeRegistry, employeeId);
+
+    // And then we can also safely associate the payment to the retrieved employee
+    addPaymentToEmployee(paymentLedger, theEmployee, writeAheadLog);
+}
+
+// Adds an Employe's Payment structure variable to the reference of a given PaymentLedger
+void addPaymentToEmployee(PaymentLedger &paymentLedger, const Employee &employee, WriteAheadLog &writeAheadLog) {
+    cout << endl;
+    const double hoursWorked = getDouble("Please type how many hours the Employee worked in total on the week", 1, MAX_HOURS_WORKED, true);;
+    const int32_t payDate = getIsoDate("Please type the pay date of the week");
+    const Payment payment {.employeeId = employee.id, .firstName = employee.firstName, .lastName = employee.lastName, .hoursWorked = hoursWorked, .regRate = employee.regRate, .payDate = payDate,
+                           .payrollPolicy = employee.payrollPolicy};
+    logPaymentAddition(writeAheadLog, payment); // Recorded first, so it survives even a crash right after
+    insertPayment(paymentLedger, payment);
+}
+
+// Appends a given Payment structure variable to the reference of a given PaymentLedger, keeping its per-employee & per pay date indexes updated
+void insertPayment(PaymentLedger &paymentLedger, const Payment &payment) {
+    PAYROLL_COUNT(PAYMENTS_INSERTED_COUNTER, 1);
+
+    // The company's running addition report & the one of the payment's pay date stay up to date
+    const PaymentFigures figures = computePaymentFigures(payment);
+    addPaymentFiguresToPayrollReport(paymentLedger.companyAdditionPayrollReport, figures);
+    addPaymentFiguresToPayDateIndex(paymentLedger.payDateIndex, payment.payDate, figures);
+    appendPaymentToColumns(paymentLedger.columns, payment);
+
+    const size_t position = paymentLedger.size() - 1;
+    paymentLedger.paymentPositionsByEmployeeId[payment.employeeId].push_back(position);
+}
+
+// Rebuilds the Payment structure variable stored at a given position of a given PaymentLedger
+Payment getPayment(const PaymentLedger &paymentLedger, const size_t position) {
+    const PaymentColumns &columns = paymentLedger.columns;
+    const uint32_t code = columns.employeeCodes[position];
+    return Payment {.employeeId = getEmployeeIdOfCode(columns, code), .firstName = getEmployeeFirstNameOfCode(columns, code), .lastName = getEmployeeLastNameOfCode(columns, code),
+                    .hoursWorked = columns.hoursWorked[position], .regRate = columns.regRates[position], .payDate = columns.payDates[position],
+                    .payrollPolicy = columns.payrollPolicies[position]};
+}
+
+// Adds the already computed figures of a payment with a given pay date into the reference of a given PayDateIndex, updating only the path of its leaf (unless the tree must be rebuilt)
+void addPaymentFiguresToPayDateIndex(PayDateIndex &payDateIndex, const int32_t payDate, const PaymentFigures &figures) {
+    vector<int32_t> &payDates = payDateIndex.payDates;
+    vector<PayrollReport> &additionsByPayDate = payDateIndex.additionsByPayDate;
+
+    // The payments mostly arrive in the order of their pay dates, so a pay date after the last one needs no search at all
+    const size_t leaf = payDates.empty() || payDates.back() < payDate ? payDates.size() : lower_bound(payDates.begin(), payDates.end(), payDate) - payDates.begin();
+    if (leaf == payDates.size() || payDates[leaf] != payDate) {
+        payDates.insert(payDates.begin() + static_cast<ptrdiff_t>(leaf), payDate);
+        additionsByPayDate.insert(additionsByPayDate.begin() + static_cast<ptrdiff_t>(leaf), PayrollReport {});
+        addPaymentFiguresToPayrollReport(additionsByPayDate[leaf], figures);
+
+        // A new last pay date just takes the next free leaf, but one in the middle moves all the following ones (& that only happens once per pay date)
+        if (leaf + 1 < payDates.size() || payDates.size() > payDateIndex.leavesCapacity) return rebuildPayDateIndexTree(payDateIndex);
+    } else {
+        addPaymentFiguresToPayrollReport(additionsByPayDate[leaf], figures);
+    }
+
+    // Only the leaf & its ancestors change
+    vector<PayrollReport> &tree = payDateIndex.tree;
+    size_t node = payDateIndex.leavesCapacity + leaf;
+    tree[node] = additionsByPayDate[leaf];
+    for (node /= 2; node >= 1; node /= 2) tree[node] = mergePayrollReports(tree[2 * node], tree[2 * node + 1]);
+}
+
+// Creates the PayDateIndex of all the payments held by some given PaymentColumns, adding up each pay date's payments in the order they were made
+PayDateIndex createPayDateIndex(const PaymentColumns &columns) {
+    PAYROLL_TIME_OPERATION(CREATE_PAY_DATE_INDEX_OPERATION);
+    PayDateIndex payDateIndex;
+    vector<int32_t> &payDates = payDateIndex.payDates;
+
+    // First the distinct pay dates (the payments of a pay period usually come together, so most repeated ones get skipped right away), so no pay date ever goes in the middle
+    for (size_t position = 0; position < columns.size(); position++) {
+        if (payDates.empty() || payDates.back() != columns.payDates[position]) payDates.push_back(columns.payDates[position]);
+    }
+    sort(payDates.begin(), payDates.end());
+    payDates.erase(unique(payDates.begin(), payDates.end()), payDates.end());
+
+    // Then each payment gets added to its pay date's addition (the leaf of the previous payment gets checked before searching for it)
+    payDateIndex.additionsByPayDate.assign(payDates.size(), PayrollReport {});
+    size_t leaf = 0;
+    for (size_t position = 0; position < columns.size(); position++) {
+        const int32_t payDate = columns.payDates[position];
+        if (payDates[leaf] != payDate) leaf = lower_bound(payDates.begin(), payDates.end(), payDate) - payDates.begin();
+        addPaymentFiguresToPayrollReport(payDateIndex.additionsByPayDate[leaf], computePaymentFigures(columns.hoursWorked[position], columns.regRates[position], columns.payrollPolicies[position]));
+    }
+
+    rebuildPayDateIndexTree(payDateIndex);
+    return payDateIndex;
+}
+
+// Rebuilds the whole tree of a given PayDateIndex from its pay dates' additions, with the smallest power of 2 leaves that fits them all
+void rebuildPayDateIndexTree(PayDateIndex &payDateIndex) {
+    payDateIndex.leavesCapacity = 1;
+    while (payDateIndex.leavesCapacity < payDateIndex.payDates.size()) payDateIndex.leavesCapacity *= 2;
+
+    // The leaves first (the unused ones stay empty), & then every node from its two children, bottom up
+    vector<PayrollReport> &tree = payDateIndex.tree;
+    tree.assign(2 * payDateIndex.leavesCapacity, PayrollReport {});
+    copy(payDateIndex.additionsByPayDate.begin(), payDateIndex.additionsByPayDate.end(), tree.begin() + static_cast<ptrdiff_t>(payDateIndex.leavesCapacity));
+    for (size_t node = payDateIndex.leavesCapacity - 1; node >= 1; node--) tree[node] = mergePayrollReports(tree[2 * node], tree[2 * node + 1]);
+}
+
+// Generates a PayrollReport with the addition of the payments of a given PaymentLedger whose pay dates are within a given range (both included), in logarithmic time
+PayrollReport createAdditionPayrollReportOfPayDates(const PaymentLedger &paymentLedger, const int32_t firstPayDate, const int32_t lastPayDate) {
+    PAYROLL_TIME_OPERATION(CREATE_PAY_DATES_ADDITION_PR_OPERATION);
+    const PayDateIndex &payDateIndex = paymentLedger.payDateIndex;
+    const vector<int32_t> &payDates = payDateIndex.payDates;
+    const vector<PayrollReport> &tree = payDateIndex.tree;
+
+    // The range's leaves: from the first pay date not before the range, to the one past its last pay date
+    const size_t firstLeaf = lower_bound(payDates.begin(), payDates.end(), firstPayDate) - payDates.begin();
+    const size_t endLeaf = upper_bound(payDates.begin(), payDates.end(), lastPayDate) - payDates.begin();
+
+    // Climbs the tree from both ends of the range at once, taking on each level the (at most 2) nodes that lie completely inside it, in the order of their pay dates
+    PayrollReport leftAddition, rightAddition;
+    for (size_t left = payDateIndex.leavesCapacity + firstLeaf, right = payDateIndex.leavesCapacity + endLeaf; left < right; left /= 2, right /= 2) {
+        if (left % 2 == 1) leftAddition = mergePayrollReports(leftAddition, tree[left++]);
+        if (right % 2 == 1) rightAddition = mergePayrollReports(tree[--right], rightAddition);
+    }
+
+    return mergePayrollReports(leftAddition, rightAddition);
+}
+
+// Gets the first & last dates (as days since 1970-01-01) of a given quarter (1 to 4) of a given year, into the given references
+void getQuarterDates(const int year, const int quarter, int32_t &firstDate, int32_t &lastDate) {
+    const int firstMonth = 3 * quarter - 2;
+    firstDate = daysFromCivilDate(year, firstMonth, 1);
+    lastDate = (quarter == 4 ? daysFromCivilDate(year + 1, 1, 1) : daysFromCivilDate(year, firstMonth + 3, 1)) - 1; // The day before the next quarter
+}
+
+// Gets the first date (as days since 1970-01-01) of the year of a given date, so the range from it to the given date is the year to date
+int32_t getFirstDateOfYear(const int32_t date) {
+    int year, month, day;
+    civilDateFromDays(date, year, month, day);
+    return daysFromCivilDate(year, 1, 1);
+}
+
+// Prints on the terminal all the payments made by the company, including those to ex employees, a given amount of them at a time (0 means all at once)
+void printAllThePayments(const PaymentLedger &paymentLedger, const size_t pageSize) {
+    cout << endl;
+    cout << "-----------------------------------------------------------------" << endl;
+    cout << "                 A L L   T H E   P A Y M E N T S                 " << endl;
+    cout << "-----------------------------------------------------------------" << endl;
+
+    // When all of them fit in a single page, there is nothing to move through
+    PaymentCursor paymentCursor = openPaymentCursor(paymentLedger, pageSize);
+    if (pageSize == 0 || paymentLedger.size() <= pageSize) {
+        printPaymentsPage(paymentCursor);
+        return;
+    }
+
+    char pageSelection;
+    do {
+        const size_t pageStart = paymentCursor.offset;
+        printPaymentsPage(paymentCursor);
+
+        cout << "Payments " << humanizeUnsignedInteger(pageStart + 1) << " - " << humanizeUnsignedInteger(paymentCursor.offset) << " of " << humanizeUnsignedInteger(paymentCursor.size());
+        if (paymentCursor.isFiltered()) cout << " made to the employee " << employeeIdToString(paymentCursor.employeeId);
+        cout << endl;
+        cout << endl;
+
+        pageSelection = getPaymentsPageSelection(paymentCursor.isFiltered());
+        switch (pageSelection) {
+            case NEXT_PAGE_OPTION:
+                if (paymentCursor.atEnd()) {
+                    cout << "That was already the last page." << endl;
+                    seekPaymentCursor(paymentCursor, pageStart);
+                }
+                break;
+            case PREVIOUS_PAGE_OPTION:
+                if (pageStart == 0) cout << "That was already the first page." << endl;
+                seekPaymentCursor(paymentCursor, pageStart >= pageSize ? pageStart - pageSize : 0);
+                break;
+            case SEEK_PAYMENT_OPTION:
+                seekPaymentCursor(paymentCursor, static_cast<size_t>(getDouble("Type the number of the payment to show the page from", 1, static_cast<double>(paymentCursor.size()), true)) - 1);
+                break;
+            case FILTER_BY_EMPLOYEE_OPTION:
+            {
+                // Any employee who ever received a payment can be chosen, even the ex employees
+                const string employeeIdText = getStringFromMessage("Type the id of the employee whose payments you want to see: ");
+                if (EmployeeId employeeId; !parseEmployeeId(employeeIdText, employeeId) || !filterPaymentCursor(paymentCursor, employeeId)) {
+                    cout << "There are no payments made to the employee " << employeeIdText << "." << endl;
+                    seekPaymentCursor(paymentCursor, pageStart);
+                }
+                break;
+            }
+            case ALL_EMPLOYEES_OPTION:
+                unfilterPaymentCursor(paymentCursor);
+                break;
+            default: ;
+        }
+    } while (pageSelection != BACK_TO_MENU_OPTION);
+}
+
+// Gets the option selected by the user, from the options to move through the pages of payments
+char getPaymentsPageSelection(const bool isFilteredByEmployee) {
+    vector<char> allowedPageOptions {NEXT_PAGE_OPTION, PREVIOUS_PAGE_OPTION, SEEK_PAYMENT_OPTION, FILTER_BY_EMPLOYEE_OPTION, BACK_TO_MENU_OPTION};
+    if (isFilteredByEmployee) allowedPageOptions.push_back(ALL_EMPLOYEES_OPTION);
+
+    cout << NEXT_PAGE_OPTION << " - Next page." << endl;
+    cout << PREVIOUS_PAGE_OPTION << " - Previous page." << endl;
+    cout << SEEK_PAYMENT_OPTION << " - Go to a payment number." << endl;
+    cout << FILTER_BY_EMPLOYEE_OPTION << " - Only the payments of an employee." << endl;
+    if (isFilteredByEmployee) cout << ALL_EMPLOYEES_OPTION << " - The payments of all the employees." << endl;
+    cout << BACK_TO_MENU_OPTION << " - Back to the menu." << endl;
+
+    char selection;
+    bool isInvalidAnswer;
+    do {
+        selection = static_cast<char>(toupper(getAlphaChar("Type your page option please"))); // Typecasting to avoid a warning
+
+        isInvalidAnswer = !isValidMenuSelection(selection, allowedPageOptions);
+        if (isInvalidAnswer) cout << "That's not one of the options above. Try again." << endl;
+    } while (isInvalidAnswer);
+
+    return selection;
+}
+
+// Opens a PaymentCursor at the first of all the payments of a given PaymentLedger, that goes through them a given amount at a time (0 means all at once)
+PaymentCursor openPaymentCursor(const PaymentLedger &paymentLedger, const size_t pageSize) {
+    return PaymentCursor {.paymentLedger = &paymentLedger, .pageSize = pageSize};
+}
+
+// Moves a given PaymentCursor to a given payment number (or to its end, if there are not that many payments)
+void seekPaymentCursor(PaymentCursor &paymentCursor, const size_t paymentNumber) {
+    paymentCursor.offset = min(paymentNumber, paymentCursor.size());
+}
+
+// Narrows a given PaymentCursor to the payments of a given employee's id, from the first one. Returns false (leaving the cursor untouched) if that employee has no payments
+bool filterPaymentCursor(PaymentCursor &paymentCursor, const EmployeeId &employeeId) {
+    // The per-employee index already has the positions of the employee's payments, in the order they were made
+    const auto indexIterator = paymentCursor.paymentLedger->paymentPositionsByEmployeeId.find(employeeId);
+    if (indexIterator == paymentCursor.paymentLedger->paymentPositionsByEmployeeId.end()) return false;
+
+    paymentCursor.employeePaymentPositions = &indexIterator->second;
+    paymentCursor.employeeId = employeeId;
+    paymentCursor.offset = 0;
+    return true;
+}
+
+// Widens a given PaymentCursor back to all the payments, from the first one
+void unfilterPaymentCursor(PaymentCursor &paymentCursor) {
+    paymentCursor.employeePaymentPositions = nullptr;
+    paymentCursor.offset = 0;
+}
+
+// Renders an appropiate length "line" conformed by dashes (& its line break), as part of a good looking Payments table
+string renderLineUnderPaymentsTableRow(const int largestFullNameLength) {
+    return string(max(0, largestFullNameLength) + 175, '-') + "\n";
+}
+
+// Prints on the terminal the next page of payments of a given PaymentCursor, moving it past them
+void printPaymentsPage(PaymentCursor &paymentCursor) {
+    PAYROLL_TIME_OPERATION(PRINT_PAYMENTS_PAGE_OPERATION);
+    // We get the length of the payment done to the employee with the largest full name (the same for every page, so they all look alike), or of the column's title
+    const PaymentLedger &paymentLedger = *paymentCursor.paymentLedger;
+    const int largestFullNameLength = max(FULL_NAME_TITLE_LENGTH, getLargestFullNameLength(paymentLedger.columns));
+
+    // The line under each row is always the same, so it gets built only once
+    TableRenderer tableRenderer(cout);
+    const string lineUnderRow = renderLineUnderPaymentsTableRow(largestFullNameLength);
+    tableRenderer.endLine();
+
+    // Table Header
+    tableRenderer.appendText(lineUnderRow);
+    tableRenderer.appendText("| Full Name ");
+    tableRenderer.appendPadding(largestFullNameLength - FULL_NAME_TITLE_LENGTH);
+    tableRenderer.appendText(" |  Pay Date  | Hrs Worked | Reg Hrs | Reg Rate | OT Hrs | OT Rate |    Reg Pay   |    OT Pay    |  Total Pay   |     FICA     | Soc Security | Total Deduc. |    Net Pay   |");
+    tableRenderer.endLine();
+    tableRenderer.appendText(lineUnderRow);
+
+    // Each one of the rows, straight from the columns (no Payment gets rebuilt, so no string gets copied)
+    const PaymentColumns &columns = paymentLedger.columns;
+    const size_t pageEnd = paymentCursor.pageSize == 0 ? paymentCursor.size() : min(paymentCursor.size(), paymentCursor.offset + paymentCursor.pageSize);
+    for (; paymentCursor.offset < pageEnd; paymentCursor.offset++) {
+        const size_t position = paymentCursor.positionOf(paymentCursor.offset);
+        const uint32_t code = columns.employeeCodes[position];
+        const double hoursWorked = columns.hoursWorked[position];
+        const double regRate = columns.regRates[position];
+        const PayrollRules &rules = PAYROLL_RULES[columns.payrollPolicies[position]];
+        const PaymentFigures figures = computePaymentFigures(hoursWorked, regRate, rules); // The very same figures as the Payment's member functions
+        const Money totalPay = figures.regPay + figures.otPay;
+        const Money totDeductions = figures.fica + figures.socSec;
+        const string_view fullName = getEmployeeFullNameOfCode(columns, code);
+
+        tableRenderer.appendText("| ");
+        tableRenderer.appendText(fullName);
+        tableRenderer.appendPadding(largestFullNameLength - static_cast<int>(fullName.size()));
+        tableRenderer.appendText(" | ");
+        tableRenderer.appendIsoDate(columns.payDates[position]);
+        tableRenderer.appendText(" | ");
+        tableRenderer.appendNumber(hoursWorked, 10);
+        tableRenderer.appendText(" | ");
+        tableRenderer.appendNumber(figures.regHours, 7);
+        tableRenderer.appendText(" | ");
+        tableRenderer.appendMoney(regRate, 8);
+        tableRenderer.appendText(" | ");
+        tableRenderer.appendNumber(figures.otHours, 6);
+        tableRenderer.appendText(" | ");
+        tableRenderer.appendMoney(regRate * rules.otMultiplier, 7);
+        for (const Money amount: {figures.regPay, figures.otPay, totalPay, figures.fica, figures.socSec, totDeductions, totalPay - totDeductions}) {
+            tableRenderer.appendText(" | ");
+            tableRenderer.appendMoney(amount.dollars(), 12);
+        }
+        tableRenderer.appendText(" |");
+        tableRenderer.endLine();
+        tableRenderer.appendText(lineUnderRow);
+    }
+}
+
+// Takes the floating point format (fixed or not, & its precision) of the given stream, where the table will be written
+TableRenderer::TableRenderer(ostream &output)
+    : output(output), numbersFormat((output.flags() & ios::floatfield) == ios::fixed ? chars_format::fixed : chars_format::general),
+      numbersPrecision(static_cast<int>(output.precision())) {
+    buffer.reserve(TABLE_OUTPUT_BLOCK_SIZE + 1024);
+}
+
+// Writes out whatever is left in the buffer
+TableRenderer::~TableRenderer() {
+    flush();
+}
+
+// Appends a given text, as it is
+void TableRenderer::appendText(const string_view text) {
+    buffer.append(text);
+}
+
+// Appends the given amount of blanks (none, if it's negative)
+void TableRenderer::appendPadding(const int blanksAmount) {
+    if (blanksAmount > 0) buffer.append(blanksAmount, ' ');
+}
+
+// Appends a given number right aligned to the given width, just as the stream itself would (through setw())
+void TableRenderer::appendNumber(const double number, const int width) {
+    char digits[64];
+    const char *const end = to_chars(digits, digits + sizeof(digits), number, numbersFormat, numbersPrecision).ptr;
+    appendPadding(width - static_cast<int>(end - digits));
+    buffer.append(digits, end - digits);
+}
+
+// Appends a given integer right aligned to the given width, just as the stream itself would (through setw())
+void TableRenderer::appendInteger(const unsigned long long integer, const int width) {
+    char digits[24];
+    const char *const end = to_chars(digits, digits + sizeof(digits), integer).ptr;
+    appendPadding(width - static_cast<int>(end - digits));
+    buffer.append(digits, end - digits);
+}
+
+// Appends a given amount of money right aligned to the given width, through the same formatting engine as monetizeDouble() (but with no string at all)
+void TableRenderer::appendMoney(const double amount, const int width) {
+    char money[FORMATTED_NUMBER_CAPACITY];
+    const char *const end = formatMoney(money, money + sizeof(money), amount);
+    appendPadding(width - static_cast<int>(end - money));
+    buffer.append(money, end - money);
+}
+
+// Appends a given employee's id, as text
+void TableRenderer::appendEmployeeId(const EmployeeId &employeeId) {
+    char employeeIdText[EMPLOYEE_ID_TEXT_LENGTH];
+    buffer.append(employeeIdText, formatEmployeeId(employeeIdText, employeeId) - employeeIdText);
+}
+
+// Appends a given date (as days since 1970-01-01), in the ISO 8601 format
+void TableRenderer::appendIsoDate(const int32_t days) {
+    char dateText[ISO_DATE_TEXT_LENGTH];
+    buffer.append(dateText, formatIsoDate(dateText, days) - dateText);
+}
+
+// Breaks the line, writing out the buffer once it has gathered a whole block
+void TableRenderer::endLine() {
+    buffer += '\n';
+    if (buffer.size() >= TABLE_OUTPUT_BLOCK_SIZE) flush();
+}
+
+// Writes out the buffer right now
+void TableRenderer::flush() {
+    output.write(buffer.data(), static_cast<streamsize>(buffer.size()));
+    output.flush();
+    buffer.clear();
+}
+
+// Prints on the terminal a PayrollReport for a specific Employee
+void generateAndPrintCurrentEmployeePayrollReports(const PaymentLedger &paymentLedger, const EmployeeRegistry &employeeRegistry, ThreadPool &reportThreadPool) {
+
+    cout << endl;
+    cout << "-----------------------------------------------------------------" << endl;
+    cout << "  C U R R E N T   E M P L O Y E E   P A Y R O L L   R E P O R T  " << endl;
+    cout << "-----------------------------------------------------------------" << endl;
+
+    // First we show the employee's table to the user, so that the user can decide for which employee he wants to print the Payment Report
+    showEmployeesTable(employeeRegistry);
+
+    const EmployeeId employeeId = getCurrentEmployeeIdFromMessage(employeeRegistry, "And now I need you to either type or copy/paste the id of the employee for whom you want to print the Payroll Report: "); // We are not leaving until we get an existing employee's id
+
+    // Ok, but now we also need to know if besides existing, the employee has associated payments too
+    const bool theEmployeeHasPayments = employeeHasPayments(paymentLedger, employeeId);
+
+    if (theEmployeeHasPayments) {
+        // Next we retrieve the Employee, for future printing purposes, as the future table will look way better with that useful extra data
+        const Employee &employee = getEmployeById(employeeRegistry, employeeId);
+
+        // Once we know that the Employee has at least an associated Payment, we can safely generate its pertinent addition & average EmployeePayrollReport
+        const PayrollReportSummary<EmployeePayrollReport> employeePayrollReportSummary = createCurrentEmployeePayrollReportSummary(paymentLedger, employee, reportThreadPool);
+
+        // And now we can finally send both to print
+        printEmployeePayrollReports(employeePayrollReportSummary.addition, employeePayrollReportSummary.average);
+    } else {
+        cout << "The selected employee has not received any payment yet. Good bye." << endl;
+    }
+}
+
+// Prints on the terminal both PayrollReports, addition & average, for the whole company
+void generateAndPrintCompanyPayrollReports(const PaymentLedger &paymentLedger) {
+#ifdef PAYROLL_VERIFY_AGGREGATES
+    // When verifying, the running addition report must match exactly the one rebuilt from scratch, & the kernels must match the Payment's member functions
+    verifyCompanyAdditionPayrollReport(paymentLedger);
+    verifyPaymentColumnKernels(paymentLedger);
+    verifyPayDateIndex(paymentLedger);
+#endif
+
+    // First we get the company's addition PayrollReport (kept running by the ledger) & then the average one, derived from it in constant time
+    const PayrollReport &additionPayrollReport = paymentLedger.companyAdditionPayrollReport;
+    const PayrollReport averagePayrollReport = createAveragePayrollReportFromAddition(additionPayrollReport);
+
+    cout << endl;
+    cout << "-----------------------------------------------------------------" << endl;
+    cout << "           C O M P A N Y   P A Y R O L L   R E P O R T           " << endl;
+    cout << "-----------------------------------------------------------------" << endl;
+
+    // And now we can finally send both to print
+    printCompanyPayrollReports(additionPayrollReport, averagePayrollReport);
+}
+
+// Generates both EmployeePayrollReports, addition & average, of a given current employee (that must have payments), with all the report workers of a given ThreadPool
+PayrollReportSummary<EmployeePayrollReport> createCurrentEmployeePayrollReportSummary(const PaymentLedger &paymentLedger, const Employee &employee, ThreadPool &reportThreadPool) {
+    PAYROLL_TIME_OPERATION(CREATE_CURRENT_EPR_SUMMARY_OPERATION);
+    // Always the same chunks merged as the same tree, whatever the amount of report workers (a single one just runs the chunks one after another), so the hours add up identically
+    PayrollReportSummary<EmployeePayrollReport> employeePayrollReportSummary;
+    employeePayrollReportSummary.addition = employeePayrollReportSummary.average = createAdditionEmployeePayrollReportInParallel(paymentLedger, employee, reportThreadPool);
+    static_cast<PayrollReport &>(employeePayrollReportSummary.average) = createAveragePayrollReportFromAddition(employeePayrollReportSummary.addition);
+    return employeePayrollReportSummary;
+}
+
+// Inserts a given Employee structure variable into the reference of a given EmployeeRegistry, indexing it by its id
+void insertEmployee(EmployeeRegistry &employeeRegistry, Employee employee) {
+    PAYROLL_COUNT(EMPLOYEES_INSERTED_COUNTER, 1);
+    employeeRegistry.positionsById.emplace(employee.id, employeeRegistry.employees.size()); // It will occupy the next position available
+    employeeRegistry.employees.push_back(move(employee));
+}
+
+// Determines if a given emloyeeID belongs to the current ones
+bool existEmployee(const EmployeeRegistry &employeeRegistry, const EmployeeId &employeeId) {
+    return employeeRegistry.positionsById.count(employeeId) > 0;
+}
+
+// Determines if a given emloyee's id has associated at least one payment
+bool employeeHasPayments(const PaymentLedger &paymentLedger, const EmployeeId &employeeId) {
+    // An employee's id only gets into the index along with its first payment, so its mere presence is enough
+    return paymentLedger.paymentPositionsByEmployeeId.count(employeeId) > 0;
+}
+
+// Retrieves an Employee structure variable by a given employee's id (that must exist)
+const Employee &getEmployeById(const EmployeeRegistry &employeeRegistry, const EmployeeId &employeeId) {
+    // Let's just return it directly, from the position stored in the index
+    return employeeRegistry.employees[employeeRegistry.positionsById.at(employeeId)];
+}
+
+// Deletes an Employee structure variable by a given employee's id
+void deleteEmployeById(EmployeeRegistry &employeeRegistry, const EmployeeId &employeeId) {
+    const auto indexIterator = employeeRegistry.positionsById.find(employeeId);
+    if (indexIterator == employeeRegistry.positionsById.end()) return; // Nothing to delete
+
+    auto &employees = employeeRegistry.employees;
+    const size_t deletedPosition = indexIterator->second;
+    employeeRegistry.positionsById.erase(indexIterator);
+
+    // The last employee takes the place of the deleted one (unless it was the deleted one itself), so no hole remains behind
+    if (const size_t lastPosition = employees.size() - 1; deletedPosition != lastPosition) {
+        employees[deletedPosition] = move(employees[lastPosition]);
+        employeeRegistry.positionsById[employees[deletedPosition].id] = deletedPosition; // The moved employee's index gets fixed
+    }
+    employees.pop_back();
+}
+
+// Asks with a given message for the id of a current employee of a given EmployeeRegistry, until getting one
+EmployeeId getCurrentEmployeeIdFromMessage(const EmployeeRegistry &employeeRegistry, const string &message) {
+    EmployeeId employeeId;
+    bool theEmployeeDoNotExist; // If the user do not exist based on the entered id (or if that's not even an id)
+
+    do {
+        const string employeeIdText = getStringFromMessage(message);
+        theEmployeeDoNotExist = !parseEmployeeId(employeeIdText, employeeId) || !existEmployee(employeeRegistry, employeeId);
+        if (theEmployeeDoNotExist)
+            cout << "We don't have an Employee with such ID. Try again please." << endl;
+    } while (theEmployeeDoNotExist);
+
+    return employeeId;
+}
+
+// Generates a new random employee's id (a version 4 UUID), out of a single 128-bit draw
+EmployeeId generateEmployeeId() {
+    // Seeded only once, with as many bits from the random device as the generator's state can take
+    static mt19937_64 generator = [] {
+        random_device device;
+        seed_seq seeds {device(), device(), device(), device(), device(), device(), device(), device()};
+        return mt19937_64(seeds);
+    }();
+
+    return generateEmployeeId(generator);
+}
+
+// Generates a new random employee's id (a version 4 UUID), out of a single 128-bit draw from a given generator
+EmployeeId generateEmployeeId(mt19937_64 &generator) {
+    // Two 64-bit draws are the whole id, instead of one draw per hexadecimal digit
+    EmployeeId employeeId {.high = generator(), .low = generator()};
+    employeeId.high = (employeeId.high & ~0xF000ULL) | 0x4000ULL; // The version (4, random), as its 13th digit
+    employeeId.low = (employeeId.low & ~(3ULL << 62)) | (2ULL << 62); // The variant (the 2 bits 10), at the start of its 17th digit
+    return employeeId;
+}
+
+// Writes the text of a given employee's id (EMPLOYEE_ID_TEXT_LENGTH characters) into a given buffer. Returns where it ended
+char *formatEmployeeId(char *first, const EmployeeId &employeeId) {
+    constexpr char hexadecimalDigits[] = "0123456789abcdef";
+    for (int digit = 0; digit < 32; digit++) {
+        if (digit == 8 || digit == 12 || digit == 16 || digit == 20) *first++ = '-';
+        const uint64_t half = digit < 16 ? employeeId.high : employeeId.low;
+        *first++ = hexadecimalDigits[(half >> (60 - 4 * (digit % 16))) & 0xF]; // From the most significant digit of each half
+    }
+    return first;
+}
+
+// Formats a given employee's id as text, to be shown. Format: bdc0a2fb-d39e-4242-9a0a-4e760153f18d
+string employeeIdToString(const EmployeeId &employeeId) {
+    char employeeIdText[EMPLOYEE_ID_TEXT_LENGTH];
+    return string(employeeIdText, formatEmployeeId(employeeIdText, employeeId));
+}
+
+// Reads a given text as an employee's id (its hexadecimal digits in either case, with its 4 dashes) into the reference of a given EmployeeId. Returns false if it's not one
+bool parseEmployeeId(const string_view text, EmployeeId &employeeId) {
+    if (text.size() != EMPLOYEE_ID_TEXT_LENGTH) return false;
+
+    EmployeeId parsedEmployeeId;
+    int digit = 0;
+    for (size_t i = 0; i < text.size(); i++) {
+        const char character = text[i];
+        if (i == 8 || i == 13 || i == 18 || i == 23) {
+            if (character != '-') return false;
+            continue;
+        }
+
+        uint64_t value;
+        if ('0' <= character && character <= '9') value = character - '0';
+        else if ('a' <= character && character <= 'f') value = character - 'a' + 10;
+        else if ('A' <= character && character <= 'F') value = character - 'A' + 10;
+        else return false;
+
+        uint64_t &half = digit++ < 16 ? parsedEmployeeId.high : parsedEmployeeId.low;
+        half = half << 4 | value;
+    }
+
+    employeeId = parsedEmployeeId;
+    return true;
+}
+
+// Computes once each one of the derived figures of a given Payment structure variable
+PaymentFigures computePaymentFigures(const Payment &payment) {
+    return computePaymentFigures(payment.hoursWorked, payment.regRate, payment.payrollPolicy);
+}
+
+// Computes once each one of the derived figures of a payment, given its worked hours, its regular rate & its payroll policy (whose rules get looked up, with no branches on it)
+PaymentFigures computePaymentFigures(const double hoursWorked, const double regRate, const PayrollPolicy payrollPolicy) {
+    return computePaymentFigures(hoursWorked, regRate, PAYROLL_RULES[payrollPolicy]);
+}
+
+// Computes once each one of the derived figures of a payment, given its worked hours, its regular rate & the payroll rules it follows
+PaymentFigures computePaymentFigures(const double hoursWorked, const double regRate, const PayrollRules &rules) {
+    // Exactly the same operations (& in the same order) as the Payment's member functions
+    const double regHours = hoursWorked <= rules.maxRegHours ? hoursWorked : rules.maxRegHours;
+    const double otHours = hoursWorked <= rules.maxRegHours ? 0 : hoursWorked - rules.maxRegHours;
+    const Money regPay = Money::fromDollars(regHours * regRate);
+    const Money otPay = Money::fromDollars(otHours * (regRate * rules.otMultiplier));
+    const Money totalPay = regPay + otPay; // Computed only once for both deductions
+    return PaymentFigures {.regHours = regHours, .otHours = otHours, .regPay = regPay, .otPay = otPay, .fica = totalPay.times(rules.ficaRate), .socSec = totalPay.times(rules.ssMedRate)};
+}
+
+// Computes once each one of the derived figures of a payment, given its worked hours & its regular rate, specialised for a given payroll policy (its rules become constants)
+template<PayrollPolicy POLICY>
+PaymentFigures computePaymentFigures(const double hoursWorked, const double regRate) {
+    static_assert(POLICY < PAYROLL_POLICIES_AMOUNT);
+    constexpr PayrollRules RULES = PAYROLL_RULES[POLICY];
+    return computePaymentFigures(hoursWorked, regRate, RULES);
+}
+
+// Calls a given callable with a given payroll policy as a compile time constant (an integral_constant), so the callable gets specialised for every policy
+template<typename Callable>
+void dispatchPayrollPolicy(const PayrollPolicy payrollPolicy, Callable callable) {
+    static_assert(PAYROLL_POLICIES_AMOUNT == 2, "Every payroll policy needs its own case");
+    if (payrollPolicy == OVERTIME_EXEMPT_PAYROLL_POLICY) callable(integral_constant<PayrollPolicy, OVERTIME_EXEMPT_PAYROLL_POLICY> {});
+    else callable(integral_constant<PayrollPolicy, STANDARD_PAYROLL_POLICY> {});
+}
+
+// Calls a given callable once per payroll policy, always in the same order, each one as a compile time constant (an integral_constant)
+template<typename Callable>
+void forEachPayrollPolicy(Callable callable) {
+    static_assert(PAYROLL_POLICIES_AMOUNT == 2, "Every payroll policy needs its own call");
+    callable(integral_constant<PayrollPolicy, STANDARD_PAYROLL_POLICY> {});
+    callable(integral_constant<PayrollPolicy, OVERTIME_EXEMPT_PAYROLL_POLICY> {});
+}
+
+// Reads a given text as a payroll policy (its name, in either case) into the reference of a given PayrollPolicy. Returns false if it's not one
+bool parsePayrollPolicy(const string_view text, PayrollPolicy &payrollPolicy) {
+    for (int policy = 0; policy < PAYROLL_POLICIES_AMOUNT; policy++) {
+        const string_view name = PAYROLL_RULES[policy].name;
+        const bool isSameName = text.size() == name.size() && equal(text.begin(), text.end(), name.begin(), [](const char a, const char b) { return tolower(a) == b; });
+        if (!isSameName) continue;
+        payrollPolicy = static_cast<PayrollPolicy>(policy);
+        return true;
+    }
+    return false;
+}
+
+// Appends the numeric data of a given Payment structure variable to the reference of some given PaymentColumns, encoding its employee's id
+void appendPaymentToColumns(PaymentColumns &columns, const Payment &payment) {
+    // The first payment of an employee gets the next code available, & the following ones just reuse it
+    const auto codeIterator = columns.employeeCodesById.find(payment.employeeId);
+    const uint32_t code = codeIterator != columns.employeeCodesById.end() ? codeIterator->second
+                                                                         : addEmployeeToColumnsDictionary(columns, payment.employeeId, payment.firstName, payment.lastName);
+
+    columns.hoursWorked.push_back(payment.hoursWorked);
+    columns.regRates.push_back(payment.regRate);
+    columns.employeeCodes.push_back(code);
+    columns.payDates.push_back(payment.payDate);
+    columns.payrollPolicies.push_back(payment.payrollPolicy);
+    columns.paymentsAmountsByPolicy[payment.payrollPolicy]++;
+}
+
+// Adds an employee to the dictionary of some given PaymentColumns, given its id & names (interning its full name). Returns its new code
+uint32_t addEmployeeToColumnsDictionary(PaymentColumns &columns, const EmployeeId &employeeId, const string_view firstName, const string_view lastName) {
+    const auto code = static_cast<uint32_t>(columns.employeeIds.size());
+    columns.employeeIds.push_back(employeeId);
+
+    // The full name gets interned as a single text, so it can be viewed whole later on (this is the only time it ever gets built)
+    string fullName;
+    fullName.reserve(firstName.size() + 1 + lastName.size());
+    fullName.append(firstName).append(" ").append(lastName);
+    columns.employeeFullNames.push_back(columns.employeeNames.intern(fullName));
+    columns.employeeFirstNameLengths.push_back(static_cast<uint32_t>(firstName.size()));
+    columns.largestFullNameLength = max(columns.largestFullNameLength, fullName.size());
+
+    columns.employeeCodesById.emplace(employeeId, code);
+    return code;
+}
+
+// Gets a view of the employee's id of a given code, from the dictionary of some given PaymentColumns
+const EmployeeId &getEmployeeIdOfCode(const PaymentColumns &columns, const uint32_t code) {
+    return columns.employeeIds[code];
+}
+
+// Gets a view of the employee's full name of a given code, from the dictionary of some given PaymentColumns
+string_view getEmployeeFullNameOfCode(const PaymentColumns &columns, const uint32_t code) {
+    return columns.employeeNames.view(columns.employeeFullNames[code]);
+}
+
+// Gets a view of the employee's first name of a given code, from the dictionary of some given PaymentColumns
+string_view getEmployeeFirstNameOfCode(const PaymentColumns &columns, const uint32_t code) {
+    return getEmployeeFullNameOfCode(columns, code).substr(0, columns.employeeFirstNameLengths[code]);
+}
+
+// Gets a view of the employee's last name of a given code, from the dictionary of some given PaymentColumns
+string_view getEmployeeLastNameOfCode(const PaymentColumns &columns, const uint32_t code) {
+    return getEmployeeFullNameOfCode(columns, code).substr(columns.employeeFirstNameLengths[code] + 1);
+}
+
+// Adds an element at the end, allocating a new chunk only when the last one is full
+template<typename T, size_t CHUNK_SIZE>
+void ChunkedVector<T, CHUNK_SIZE>::push_back(T element) {
+    if (elementsAmount == chunks.size() * CHUNK_SIZE) chunks.push_back(unique_ptr<T[]>(new T[CHUNK_SIZE]));
+    chunks[elementsAmount / CHUNK_SIZE][elementsAmount % CHUNK_SIZE] = move(element);
+    elementsAmount++;
+}
+
+// Adds a given run of elements at the end, copying them a whole chunk at a time
+template<typename T, size_t CHUNK_SIZE>
+void ChunkedVector<T, CHUNK_SIZE>::append(const T *elements, size_t elementsToAppend) {
+    while (elementsToAppend > 0) {
+        if (elementsAmount == chunks.size() * CHUNK_SIZE) chunks.push_back(unique_ptr<T[]>(new T[CHUNK_SIZE]));
+        const size_t copiedAmount = min(elementsToAppend, CHUNK_SIZE - elementsAmount % CHUNK_SIZE);
+        copy(elements, elements + copiedAmount, chunks[elementsAmount / CHUNK_SIZE].get() + elementsAmount % CHUNK_SIZE);
+        elements += copiedAmount;
+        elementsToAppend -= copiedAmount;
+        elementsAmount += copiedAmount;
+    }
+}
+
+// The handle of the given text, storing it first if it was not stored yet
+StringHandle StringPool::intern(const string_view text) {
+    if (const auto handleIterator = handlesByText.find(text); handleIterator != handlesByText.end()) return handleIterator->second;
+
+    // A new text goes right after the previous one, unless it does not fit in the last block anymore
+    if (text.size() > lastBlockFreeBytes) {
+        const size_t blockSize = max(STRING_POOL_BLOCK_SIZE, text.size());
+        blocks.push_back(make_unique<char[]>(blockSize));
+        lastBlockFreeSpace = blocks.back().get();
+        lastBlockFreeBytes = blockSize;
+    }
+    char *const storedText = lastBlockFreeSpace;
+    memcpy(storedText, text.data(), text.size());
+    lastBlockFreeSpace += text.size();
+    lastBlockFreeBytes -= text.size();
+
+    const auto handle = static_cast<StringHandle>(texts.size());
+    texts.emplace_back(storedText, text.size());
+    handlesByText.emplace(texts.back(), handle);
+    return handle;
+}
+
+// Generates a PayrollReport with the addition of all the payments held by some given PaymentColumns, through the fastest aggregation kernel available
+PayrollReport createAdditionPayrollReport(const PaymentColumns &columns) {
+    KernelLanes lanes;
+
+    // Every chunk of the columns is full (a multiple of 4 payments) but the last one, so each payment ends up in the same lane as if they were all contiguous
+    for (size_t chunk = 0; chunk < columns.hoursWorked.chunksAmount(); chunk++) {
+        accumulatePaymentColumns(columns.hoursWorked.chunkData(chunk), columns.regRates.chunkData(chunk), columns.payrollPolicies.chunkData(chunk), columns.hoursWorked.chunkSize(chunk),
+                                 columns.hasMixedPayrollPolicies(), lanes);
+    }
+
+    return combineKernelLanes(lanes, columns.size());
+}
+
+// Aggregation kernel: adds into a PayrollReport the payments of some given contiguous columns (hours worked, regular rates & payroll policies),
+// using the AVX2 kernels when the CPU supports them. Told if the payments follow a mixed set of payroll policies
+PayrollReport aggregatePaymentColumns(const double *hoursWorked, const double *regRates, const PayrollPolicy *payrollPolicies, const size_t paymentsAmount,
+                                      const bool hasMixedPayrollPolicies) {
+    KernelLanes lanes;
+    accumulatePaymentColumns(hoursWorked, regRates, payrollPolicies, paymentsAmount, hasMixedPayrollPolicies, lanes);
+    return combineKernelLanes(lanes, paymentsAmount);
+}
+
+// Aggregation kernel: accumulates the payments of some given contiguous columns into the reference of some given per-lane accumulators, using the AVX2 kernels when the CPU supports them.
+// The first payment goes to the first lane, so a run of columns can be accumulated piece by piece (as long as every piece but the last has a multiple of 4 payments).
+// Payments that all follow one payroll policy go through the kernel specialised for it, & a mixed set of them through one masked pass per policy
+void accumulatePaymentColumns(const double *hoursWorked, const double *regRates, const PayrollPolicy *payrollPolicies, const size_t paymentsAmount,
+                              const bool hasMixedPayrollPolicies, KernelLanes &lanes) {
+#ifdef PAYROLL_HAS_AVX2_KERNELS
+    static const bool cpuSupportsAvx2 = __builtin_cpu_supports("avx2"); // Only checked once
+    if (cpuSupportsAvx2) return accumulatePaymentColumnsAvx2(hoursWorked, regRates, payrollPolicies, paymentsAmount, hasMixedPayrollPolicies, lanes);
+#endif
+    accumulatePaymentColumnsScalar(hoursWorked, regRates, payrollPolicies, paymentsAmount, hasMixedPayrollPolicies, lanes);
+}
+
+// Portable aggregation kernels: picks the one specialised for the payroll policy of the payments (or runs one masked pass per policy, when they are mixed)
+void accumulatePaymentColumnsScalar(const double *hoursWorked, const double *regRates, const PayrollPolicy *payrollPolicies, const size_t paymentsAmount,
+                                    const bool hasMixedPayrollPolicies, KernelLanes &lanes) {
+    if (paymentsAmount == 0) return;
+    if (!hasMixedPayrollPolicies) return dispatchPayrollPolicy(payrollPolicies[0], [&](const auto policy) {
+        accumulatePolicyPaymentColumnsScalar<decltype(policy)::value, false>(hoursWorked, regRates, payrollPolicies, paymentsAmount, lanes);
+    });
+    forEachPayrollPolicy([&](const auto policy) { accumulatePolicyPaymentColumnsScalar<decltype(policy)::value, true>(hoursWorked, regRates, payrollPolicies, paymentsAmount, lanes); });
+}
+
+// Portable aggregation kernel, specialised for a given payroll policy: same lane layout (& therefore the very same results) as the AVX2 one, but one payment at a time.
+// A masked one adds zeros for the payments of the other policies, without branching on them
+template<PayrollPolicy POLICY, bool IS_MASKED>
+void accumulatePolicyPaymentColumnsScalar(const double *hoursWorked, const double *regRates, const PayrollPolicy *payrollPolicies, const size_t paymentsAmount,
+                                          KernelLanes &lanes) {
+    // Every payment goes to the lane it would occupy inside an AVX2 register, so the additions happen in the same order as in the AVX2 kernel
+    for (size_t i = 0; i < paymentsAmount; i++) {
+        const PaymentFigures figures = computePaymentFigures<POLICY>(hoursWorked[i], regRates[i]);
+        const bool isIncluded = !IS_MASKED || payrollPolicies[i] == POLICY;
+        const size_t lane = i % KERNEL_LANES;
+        lanes.hours[0][lane] += isIncluded ? figures.regHours : 0.0;
+        lanes.hours[1][lane] += isIncluded ? figures.otHours : 0.0;
+        lanes.cents[0][lane] += isIncluded ? figures.regPay.cents : 0;
+        lanes.cents[1][lane] += isIncluded ? figures.otPay.cents : 0;
+        lanes.cents[2][lane] += isIncluded ? figures.fica.cents : 0;
+        lanes.cents[3][lane] += isIncluded ? figures.socSec.cents : 0;
+    }
+}
+
+#ifdef PAYROLL_HAS_AVX2_KERNELS
+// AVX2 aggregation kernels: picks the one specialised for the payroll policy of the payments (or runs one masked pass per policy, when they are mixed)
+void accumulatePaymentColumnsAvx2(const double *hoursWorked, const double *regRates, const PayrollPolicy *payrollPolicies, const size_t paymentsAmount,
+                                  const bool hasMixedPayrollPolicies, KernelLanes &lanes) {
+    if (paymentsAmount == 0) return;
+    if (!hasMixedPayrollPolicies) return dispatchPayrollPolicy(payrollPolicies[0], [&](const auto policy) {
+        accumulatePolicyPaymentColumnsAvx2<decltype(policy)::value, false>(hoursWorked, regRates, payrollPolicies, paymentsAmount, lanes);
+    });
+    forEachPayrollPolicy([&](const auto policy) { accumulatePolicyPaymentColumnsAvx2<decltype(policy)::value, true>(hoursWorked, regRates, payrollPolicies, paymentsAmount, lanes); });
+}
+
+// AVX2 aggregation kernel, specialised for a given payroll policy: processes 4 payments at a time, one per lane.
+// A masked one adds zeros for the payments of the other policies, without branching on them
+template<PayrollPolicy POLICY, bool IS_MASKED>
+__attribute__((target("avx2"))) void accumulatePolicyPaymentColumnsAvx2(const double *hoursWorked, const double *regRates, const PayrollPolicy *payrollPolicies,
+                                                                        const size_t paymentsAmount, KernelLanes &lanes) {
+    constexpr PayrollRules RULES = PAYROLL_RULES[POLICY];
+    const __m256d maxRegHours = _mm256_set1_pd(RULES.maxRegHours);
+    const __m256d otMultiplier = _mm256_set1_pd(RULES.otMultiplier);
+    const __m256d ficaRate = _mm256_set1_pd(RULES.ficaRate);
+    const __m256d ssMedRate = _mm256_set1_pd(RULES.ssMedRate);
+    const __m256d centsPerDollar = _mm256_set1_pd(100.0);
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256i policy = _mm256_set1_epi64x(POLICY);
+    __m256d regHoursSum = _mm256_loadu_pd(lanes.hours[0]), otHoursSum = _mm256_loadu_pd(lanes.hours[1]);
+    __m256i regPaySum = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lanes.cents[0])), otPaySum = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lanes.cents[1]));
+    __m256i ficaSum = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lanes.cents[2])), socSecSum = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lanes.cents[3]));
+
+    const size_t vectorizedAmount = paymentsAmount - paymentsAmount % KERNEL_LANES;
+    for (size_t i = 0; i < vectorizedAmount; i += KERNEL_LANES) {
+        const __m256d hours = _mm256_loadu_pd(hoursWorked + i);
+        const __m256d rate = _mm256_loadu_pd(regRates + i);
+
+        // Same operations as the Payment's member functions (the blends play the role of their ternary operators), with no fused multiply-adds.
+        // The money gets rounded to whole cents just like Money does it, & only then gets added up, as integers
+        const __m256d isRegularOnly = _mm256_cmp_pd(hours, maxRegHours, _CMP_LE_OQ);
+        __m256d regHours = _mm256_blendv_pd(maxRegHours, hours, isRegularOnly);
+        __m256d otHours = _mm256_blendv_pd(_mm256_sub_pd(hours, maxRegHours), zero, isRegularOnly);
+        __m256d regPay, otPay;
+        __m256i regPayCents = roundCentsAvx2(_mm256_mul_pd(_mm256_mul_pd(regHours, rate), centsPerDollar), regPay);
+        __m256i otPayCents = roundCentsAvx2(_mm256_mul_pd(_mm256_mul_pd(otHours, _mm256_mul_pd(rate, otMultiplier)), centsPerDollar), otPay);
+        __m256d totalPay = _mm256_add_pd(regPay, otPay); // Exact, as both are whole cents
+
+        if constexpr (IS_MASKED) {
+            // The 4 policies' bytes get widened to 64 bits, so the payments of other policies get all their figures zeroed (the deductions come from the zeroed total pay)
+            int32_t policies;
+            memcpy(&policies, payrollPolicies + i, sizeof(policies));
+            const __m256d isIncluded = _mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_cvtepu8_epi64(_mm_cvtsi32_si128(policies)), policy));
+            regHours = _mm256_and_pd(regHours, isIncluded);
+            otHours = _mm256_and_pd(otHours, isIncluded);
+            regPayCents = _mm256_and_si256(regPayCents, _mm256_castpd_si256(isIncluded));
+            otPayCents = _mm256_and_si256(otPayCents, _mm256_castpd_si256(isIncluded));
+            totalPay = _mm256_and_pd(totalPay, isIncluded);
+        }
+
+        regHoursSum = _mm256_add_pd(regHoursSum, regHours);
+        otHoursSum = _mm256_add_pd(otHoursSum, otHours);
+        regPaySum = _mm256_add_epi64(regPaySum, regPayCents);
+        otPaySum = _mm256_add_epi64(otPaySum, otPayCents);
+        ficaSum = _mm256_add_epi64(ficaSum, roundCentsAvx2(_mm256_mul_pd(totalPay, ficaRate)));
+        socSecSum = _mm256_add_epi64(socSecSum, roundCentsAvx2(_mm256_mul_pd(totalPay, ssMedRate)));
+    }
+
+    _mm256_storeu_pd(lanes.hours[0], regHoursSum);
+    _mm256_storeu_pd(lanes.hours[1], otHoursSum);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes.cents[0]), regPaySum);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes.cents[1]), otPaySum);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes.cents[2]), ficaSum);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes.cents[3]), socSecSum);
+
+    // The remaining payments (less than 4) go one by one to the very same lanes they would have occupied (the vectorized ones are a multiple of 4)
+    accumulatePolicyPaymentColumnsScalar<POLICY, IS_MASKED>(hoursWorked + vectorizedAmount, regRates + vectorizedAmount, payrollPolicies + vectorizedAmount,
+                                                            paymentsAmount - vectorizedAmount, lanes);
+}
+
+// Rounds 4 given amounts of cents to whole ones, with the very same saturation & rounding as Money::fromCents(), as 64-bit integers
+// (AVX2 has no conversion from doubles to 64-bit integers of its own). The rounded amounts also go, still as doubles, into the reference of a given register
+__attribute__((target("avx2"))) __m256i roundCentsAvx2(const __m256d cents, __m256d &roundedCents) {
+    // The max instruction returns its second operand when the first one is NaN, so NaN saturates downwards (just like in Money::fromCents())
+    const __m256d maxRoundedCents = _mm256_set1_pd(MAX_ROUNDED_CENTS);
+    const __m256d boundedCents = _mm256_min_pd(_mm256_max_pd(cents, _mm256_set1_pd(-MAX_ROUNDED_CENTS)), maxRoundedCents);
+    roundedCents = _mm256_round_pd(boundedCents, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+
+    // Once shifted, every whole amount has the shifter's exponent, with its integer right in the low bits of the mantissa, so subtracting the shifter's bits leaves just that integer
+    const __m256d shifter = _mm256_set1_pd(CENTS_ROUNDING_SHIFTER);
+    return _mm256_sub_epi64(_mm256_castpd_si256(_mm256_add_pd(roundedCents, shifter)), _mm256_castpd_si256(shifter));
+}
+
+// Rounds 4 given amounts of cents to whole ones, with the very same saturation & rounding as Money::fromCents(), as 64-bit integers
+__attribute__((target("avx2"))) __m256i roundCentsAvx2(const __m256d cents) {
+    __m256d roundedCents;
+    return roundCentsAvx2(cents, roundedCents);
+}
+#endif
+
+// Turns the per-lane accumulators of an aggregation kernel into a PayrollReport, always adding the lanes in the same order
+PayrollReport combineKernelLanes(const KernelLanes &lanes, const size_t paymentsAmount) {
+    double hours[KERNEL_HOURS_FIELDS];
+    for (int field = 0; field < KERNEL_HOURS_FIELDS; field++) {
+        hours[field] = (lanes.hours[field][0] + lanes.hours[field][1]) + (lanes.hours[field][2] + lanes.hours[field][3]);
+    }
+    Money money[KERNEL_MONEY_FIELDS];
+    for (int field = 0; field < KERNEL_MONEY_FIELDS; field++) {
+        money[field].cents = lanes.cents[field][0] + lanes.cents[field][1] + lanes.cents[field][2] + lanes.cents[field][3];
+    }
+
+    return PayrollReport {.paymentsAmount = static_cast<int>(paymentsAmount), .regHours = hours[0], .otHours = hours[1], .regPay = money[0], .otPay = money[1], .fica = money[2], .socSec = money[3]};
+}
+
+// Adds the data of a given Payment structure variable into the reference of a given (addition) PayrollReport
+void addPaymentToPayrollReport(PayrollReport &anAdditionPayrollReport, const Payment &payment) {
+    addPaymentFiguresToPayrollReport(anAdditionPayrollReport, computePaymentFigures(payment));
+}
+
+// Adds the already computed figures of a payment into the reference of a given (addition) PayrollReport
+void addPaymentFiguresToPayrollReport(PayrollReport &anAdditionPayrollReport, const PaymentFigures &figures) {
+    anAdditionPayrollReport.paymentsAmount++;
+    anAdditionPayrollReport.regHours += figures.regHours;
+    anAdditionPayrollReport.otHours += figures.otHours;
+    anAdditionPayrollReport.regPay += figures.regPay;
+    anAdditionPayrollReport.otPay += figures.otPay;
+    anAdditionPayrollReport.fica += figures.fica;
+    anAdditionPayrollReport.socSec += figures.socSec;
+}
+
+// Generates the addition & average EmployeePayrollReports of every employee that has received payments (current & ex employees), grouping all the payments in a single pass
+vector<PayrollReportSummary<EmployeePayrollReport>> createAllEmployeesPayrollReportSummaries(const PaymentLedger &paymentLedger, const EmployeeReportsOrder order) {
+    PAYROLL_TIME_OPERATION(CREATE_ALL_EPR_SUMMARIES_OPERATION);
+    const PaymentColumns &columns = paymentLedger.columns;
+
+    // The employee column is dictionary-encoded, so the groups are just the positions of a vector (by code), with no hashing at all during the pass
+    vector<PayrollReport> additionsByCode(columns.employeeIds.size());
+    for (size_t i = 0; i < columns.size(); i++) {
+        addPaymentFiguresToPayrollReport(additionsByCode[columns.employeeCodes[i]], computePaymentFigures(columns.hoursWorked[i], columns.regRates[i], columns.payrollPolicies[i]));
+    }
+
+    // Each group becomes a summary associated to its employee, with its average derived from its addition
+    vector<PayrollReportSummary<EmployeePayrollReport>> summaries;
+    summaries.reserve(additionsByCode.size());
+    for (uint32_t code = 0; code < additionsByCode.size(); code++) {
+        PayrollReportSummary<EmployeePayrollReport> summary;
+        summary.addition = EmployeePayrollReport {.employeeId = getEmployeeIdOfCode(columns, code), .employeeFullName = getEmployeeFullNameOfCode(columns, code)};
+        static_cast<PayrollReport &>(summary.addition) = additionsByCode[code];
+        summary.average = summary.addition;
+        static_cast<PayrollReport &>(summary.average) = createAveragePayrollReportFromAddition(additionsByCode[code]);
+        summaries.push_back(move(summary));
+    }
+
+    // Determines the value by which a given summary must be sorted
+    const auto sortingValue = [order](const PayrollReportSummary<EmployeePayrollReport> &summary) {
+        return order == BY_NET_PAY ? summary.addition.netPay().dollars() : summary.addition.regHours + summary.addition.otHours;
+    };
+
+    // From the largest to the smallest. The stable sort keeps the ties in the order in which the employees got their first payment
+    stable_sort(summaries.begin(), summaries.end(), [&](const auto &a, const auto &b) { return sortingValue(a) > sortingValue(b); });
+
+    return summaries;
+}
+
+// Generates in a single pass the addition & average PayrollReports (and optionally their dispersion) of all the Payment structure variables of the whole company
+PayrollReportSummary<PayrollReport> createPayrollReportSummary(const vector<Payment> &payments, const bool withDispersion) {
+    return summarizePayments(PayrollReport {}, [&](const auto &visit) {
+        for (const Payment &payment: payments) visit(computePaymentFigures(payment));
+    }, withDispersion);
+}
+
+// Creates an empty EmployeePayrollReport associated to a given employee (through the texts interned by the dictionary of a given PaymentLedger,
+// where every employee with payments is. One without them only gets its id associated)
+EmployeePayrollReport createEmptyEmployeePayrollReport(const PaymentLedger &paymentLedger, const Employee &employee) {
+    const PaymentColumns &columns = paymentLedger.columns;
+    const auto codeIterator = columns.employeeCodesById.find(employee.id);
+    if (codeIterator == columns.employeeCodesById.end()) return EmployeePayrollReport {.employeeId = employee.id};
+    return EmployeePayrollReport {.employeeId = getEmployeeIdOfCode(columns, codeIterator->second), .employeeFullName = getEmployeeFullNameOfCode(columns, codeIterator->second)};
+}
+
+// Generates in a single pass the addition & average EmployeePayrollReports (and optionally their dispersion) of all the Payment structure variables related to a given employee
+PayrollReportSummary<EmployeePayrollReport> createEmployeePayrollReportSummary(const PaymentLedger &paymentLedger, const Employee &employee, const bool withDispersion) {
+    const EmployeePayrollReport anEmployeePayrollReport = createEmptyEmployeePayrollReport(paymentLedger, employee); // Gets associated to the employee
+    const auto indexIterator = paymentLedger.paymentPositionsByEmployeeId.find(employee.id);
+    const PaymentColumns &columns = paymentLedger.columns;
+
+    return summarizePayments(anEmployeePayrollReport, [&](const auto &visit) {
+        if (indexIterator == paymentLedger.paymentPositionsByEmployeeId.end()) return; // An employee without payments has nothing to visit
+        for (const size_t position: indexIterator->second) visit(computePaymentFigures(columns.hoursWorked[position], columns.regRates[position], columns.payrollPolicies[position]));
+    }, withDispersion);
+}
+
+// Generates in parallel a PayrollReport with the addition of all the payments held by some given PaymentColumns, merging the chunks' partial reports deterministically
+PayrollReport createAdditionPayrollReportInParallel(const PaymentColumns &columns, ThreadPool &threadPool) {
+    PAYROLL_TIME_OPERATION(CREATE_ADDITION_PR_IN_PARALLEL_OPERATION);
+    PAYROLL_COUNT(PAYMENTS_AGGREGATED_COUNTER, columns.hoursWorked.size());
+    // Each chunk of the report is exactly one chunk of the columns, so the aggregation kernel runs straight over it
+    return aggregateChunksInParallel(columns.hoursWorked.chunksAmount(), [&](const size_t chunk) {
+        return aggregatePaymentColumns(columns.hoursWorked.chunkData(chunk), columns.regRates.chunkData(chunk), columns.payrollPolicies.chunkData(chunk),
+                                       columns.hoursWorked.chunkSize(chunk), columns.hasMixedPayrollPolicies());
+    }, threadPool);
+}
+
+// Generates in parallel a PayrollReport with the addition of all the payments held by some given contiguous columns (hours worked, regular rates & payroll policies),
+// merging the chunks' partial reports deterministically. Told if the payments follow a mixed set of payroll policies
+PayrollReport createAdditionPayrollReportInParallel(const double *hoursWorked, const double *regRates, const PayrollPolicy *payrollPolicies, const size_t paymentsAmount,
+                                                    const bool hasMixedPayrollPolicies, ThreadPool &threadPool) {
+    const size_t chunksAmount = (paymentsAmount + PARALLEL_REPORT_CHUNK_SIZE - 1) / PARALLEL_REPORT_CHUNK_SIZE;
+
+    // Each chunk is a contiguous range of the columns, so the aggregation kernel runs straight over it
+    return aggregateChunksInParallel(chunksAmount, [&](const size_t chunk) {
+        const size_t firstPayment = chunk * PARALLEL_REPORT_CHUNK_SIZE;
+        const size_t chunkPaymentsAmount = min(PARALLEL_REPORT_CHUNK_SIZE, paymentsAmount - firstPayment);
+        return aggregatePaymentColumns(hoursWorked + firstPayment, regRates + firstPayment, payrollPolicies + firstPayment, chunkPaymentsAmount, hasMixedPayrollPolicies);
+    }, threadPool);
+}
+
+// Generates in parallel a PayrollReport with the addition of all the payments of a given ledger file, straight from its mapped pages (no copies at all)
+PayrollReport createAdditionPayrollReport(const MappedLedgerFile &ledgerFile, ThreadPool &threadPool) {
+    PAYROLL_TIME_OPERATION(CREATE_LEDGER_FILE_ADDITION_PR_OPERATION);
+    PAYROLL_COUNT(PAYMENTS_AGGREGATED_COUNTER, ledgerFile.header->paymentsAmount);
+    const uint64_t (&paymentsAmountsByPolicy)[PAYROLL_POLICIES_AMOUNT] = ledgerFile.header->paymentsAmountsByPolicy;
+    const bool hasMixedPayrollPolicies = count_if(begin(paymentsAmountsByPolicy), end(paymentsAmountsByPolicy), [](const uint64_t amount) { return amount > 0; }) > 1;
+    return createAdditionPayrollReportInParallel(ledgerFile.hoursWorked, ledgerFile.regRates, ledgerFile.payrollPolicies, ledgerFile.header->paymentsAmount, hasMixedPayrollPolicies, threadPool);
+}
+
+// Opens a given ledger file into the reference of a given MappedLedgerFile, validating its layout. Tells if it was opened, if it does not exist, or if it can't be used
+LedgerFileOpening openLedgerFile(const string &path, MappedLedgerFile &ledgerFile) {
+    error_code errorCode;
+    if (!filesystem::exists(path, errorCode) && !errorCode) return LEDGER_FILE_MISSING; // Not an error: there is just nothing saved yet
+
+#ifndef _WIN32
+    const int fileDescriptor = open(path.c_str(), O_RDONLY);
+    struct stat fileStatus {};
+    if (fileDescriptor < 0 || fstat(fileDescriptor, &fileStatus) != 0) {
+        if (fileDescriptor >= 0) close(fileDescriptor);
+        cerr << "The ledger file " << path << " could not be opened." << endl;
+        return LEDGER_FILE_UNUSABLE;
+    }
+    ledgerFile.size = static_cast<size_t>(fileStatus.st_size);
+    if (ledgerFile.size > 0) {
+        void *address = mmap(nullptr, ledgerFile.size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+        if (address != MAP_FAILED) {
+            ledgerFile.bytes = static_cast<const char *>(address);
+            ledgerFile.isMapped = true;
+        }
+    }
+    close(fileDescriptor); // The mapping stays valid without the descriptor
+#endif
+
+    // When the file could not be mapped, it just gets read into memory as it is
+    if (!ledgerFile.isMapped) {
+        ifstream file(path, ios::binary);
+        ledgerFile.fallbackBuffer.assign(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+        ledgerFile.bytes = ledgerFile.fallbackBuffer.data();
+        ledgerFile.size = ledgerFile.fallbackBuffer.size();
+    }
+
+    // Determines if a given section (offset & size in bytes) lies completely inside the file, starting at an offset aligned for its elements (a multiple of their size, up to 8).
+    // The pay dates follow 4 bytes long employee codes, so with an odd amount of payments they start halfway between two multiples of 8
+    const auto isValidSection = [&](const uint64_t offset, const uint64_t elementsAmount, const uint64_t elementSize) {
+        return offset % min<uint64_t>(elementSize, 8) == 0 && offset <= ledgerFile.size && elementsAmount <= (ledgerFile.size - offset) / elementSize;
+    };
+
+    const auto *header = reinterpret_cast<const LedgerFileHeader *>(ledgerFile.bytes);
+    const bool isValid = ledgerFile.size >= sizeof(LedgerFileHeader) && memcmp(header->magic, LEDGER_FILE_MAGIC, sizeof(LEDGER_FILE_MAGIC)) == 0 &&
+                         (header->version == LEDGER_FILE_VERSION || header->version == DOLLARS_REPORT_LEDGER_FILE_VERSION) && header->headerSize == sizeof(LedgerFileHeader) &&
+                         isValidSection(header->employeesOffset, header->employeesAmount, sizeof(LedgerFileEmployee)) &&
+                         isValidSection(header->dictionaryOffset, header->dictionaryEntriesAmount, sizeof(LedgerFileDictionaryEntry)) &&
+                         isValidSection(header->hoursWorkedOffset, header->paymentsAmount, sizeof(double)) &&
+                         isValidSection(header->regRatesOffset, header->paymentsAmount, sizeof(double)) &&
+                         isValidSection(header->employeeCodesOffset, header->paymentsAmount, sizeof(uint32_t)) &&
+                         isValidSection(header->payDatesOffset, header->paymentsAmount, sizeof(int32_t)) &&
+                         isValidSection(header->payrollPoliciesOffset, header->paymentsAmount, sizeof(PayrollPolicy)) &&
+                         isValidSection(header->stringTableOffset, header->stringTableSize, 1) &&
+                         header->reportPaymentsAmount == static_cast<int64_t>(header->paymentsAmount);
+    if (!isValid) {
+        cerr << "The ledger file " << path << " is not a valid version " << DOLLARS_REPORT_LEDGER_FILE_VERSION << " or " << LEDGER_FILE_VERSION << " ledger file." << endl;
+        return LEDGER_FILE_UNUSABLE;
+    }
+
+    // Every payroll policy has to be a known one, & the payments of each one have to be exactly as many as the header says: the reports straight from the file
+    // aggregate the policies in place, so an unknown one would silently leave its payment's money out, & a wrong amount would pick the wrong kernel
+    const auto *employees = reinterpret_cast<const LedgerFileEmployee *>(ledgerFile.bytes + header->employeesOffset);
+    const auto *payrollPolicies = reinterpret_cast<const PayrollPolicy *>(ledgerFile.bytes + header->payrollPoliciesOffset);
+    bool hasKnownPayrollPolicies = all_of(employees, employees + header->employeesAmount, [](const LedgerFileEmployee &employee) { return employee.payrollPolicy < PAYROLL_POLICIES_AMOUNT; });
+    uint64_t paymentsAmountsByPolicy[PAYROLL_POLICIES_AMOUNT] {};
+    for (uint64_t position = 0; position < header->paymentsAmount && hasKnownPayrollPolicies; position++) {
+        hasKnownPayrollPolicies = payrollPolicies[position] < PAYROLL_POLICIES_AMOUNT;
+        if (hasKnownPayrollPolicies) paymentsAmountsByPolicy[payrollPolicies[position]]++;
+    }
+    if (!hasKnownPayrollPolicies || !equal(begin(paymentsAmountsByPolicy), end(paymentsAmountsByPolicy), begin(header->paymentsAmountsByPolicy))) {
+        cerr << "The ledger file " << path << " has unknown payroll policies, or payments of each one other than the amounts in its header." << endl;
+        return LEDGER_FILE_UNUSABLE;
+    }
+
+    // Every section gets used in place
+    ledgerFile.header = header;
+    ledgerFile.employees = employees;
+    ledgerFile.dictionary = reinterpret_cast<const LedgerFileDictionaryEntry *>(ledgerFile.bytes + header->dictionaryOffset);
+    ledgerFile.hoursWorked = reinterpret_cast<const double *>(ledgerFile.bytes + header->hoursWorkedOffset);
+    ledgerFile.regRates = reinterpret_cast<const double *>(ledgerFile.bytes + header->regRatesOffset);
+    ledgerFile.employeeCodes = reinterpret_cast<const uint32_t *>(ledgerFile.bytes + header->employeeCodesOffset);
+    ledgerFile.payDates = reinterpret_cast<const int32_t *>(ledgerFile.bytes + header->payDatesOffset);
+    ledgerFile.payrollPolicies = payrollPolicies;
+    ledgerFile.stringTable = ledgerFile.bytes + header->stringTableOffset;
+
+    // A version 5 file has the very same layout, but the money of its report was added up in dollars (as doubles, so it's not exact), so the report gets rebuilt from the payments,
+    // one by one in their order (just like the running report added them up)
+    if (header->version == DOLLARS_REPORT_LEDGER_FILE_VERSION) {
+        for (uint64_t position = 0; position < header->paymentsAmount; position++) {
+            addPaymentFiguresToPayrollReport(ledgerFile.payrollReport, computePaymentFigures(ledgerFile.hoursWorked[position], ledgerFile.regRates[position], payrollPolicies[position]));
+        }
+    } else {
+        ledgerFile.payrollReport = PayrollReport {.paymentsAmount = static_cast<int>(header->reportPaymentsAmount), .regHours = header->reportRegHours, .otHours = header->reportOtHours,
+                                                  .regPay = Money {header->reportRegPayCents}, .otPay = Money {header->reportOtPayCents},
+                                                  .fica = Money {header->reportFicaCents}, .socSec = Money {header->reportSocSecCents}};
+    }
+    return LEDGER_FILE_OPENED;
+}
+
+// Unmaps the ledger file (if it was mapped at all)
+MappedLedgerFile::~MappedLedgerFile() {
+#ifndef _WIN32
+    if (isMapped) munmap(const_cast<char *>(bytes), size);
+#endif
+}
+
+// Gets a view of a given string stored inside the string table of a given ledger file
+string_view getLedgerFileString(const MappedLedgerFile &ledgerFile, const LedgerFileString &fileString) {
+    const uint64_t tableSize = ledgerFile.header->stringTableSize;
+    if (fileString.offset > tableSize || fileString.length > tableSize - fileString.offset) return {}; // A broken reference just becomes an empty string
+    return {ledgerFile.stringTable + fileString.offset, fileString.length};
+}
+
+// Gets the company's running addition PayrollReport of a given ledger file (the one stored in its header, or the one rebuilt when opening a version 5 file)
+PayrollReport getLedgerFilePayrollReport(const MappedLedgerFile &ledgerFile) {
+    return ledgerFile.payrollReport;
+}
+
+// Loads the whole system (employees & payments) from a given opened ledger file, into the references of a given EmployeeRegistry & PaymentLedger
+void loadLedgerFile(const MappedLedgerFile &ledgerFile, EmployeeRegistry &employeeRegistry, PaymentLedger &paymentLedger) {
+    PAYROLL_TIME_OPERATION(LOAD_LEDGER_FILE_OPERATION);
+    const LedgerFileHeader &header = *ledgerFile.header;
+
+    // The current employees (only their names need to be copied out of the string table)
+    employeeRegistry = EmployeeRegistry {};
+    for (uint64_t i = 0; i < header.employeesAmount; i++) {
+        const LedgerFileEmployee &fileEmployee = ledgerFile.employees[i];
+        insertEmployee(employeeRegistry, Employee {.id = fileEmployee.id, .firstName = string(getLedgerFileString(ledgerFile, fileEmployee.firstName)),
+                                                   .lastName = string(getLedgerFileString(ledgerFile, fileEmployee.lastName)), .regRate = fileEmployee.regRate,
+                                                   .payrollPolicy = fileEmployee.payrollPolicy});
+    }
+
+    // The payments' employee dictionary (one entry per employee that ever received a payment)
+    paymentLedger = PaymentLedger {};
+    PaymentColumns &columns = paymentLedger.columns;
+    for (uint64_t code = 0; code < header.dictionaryEntriesAmount; code++) {
+        const LedgerFileDictionaryEntry &entry = ledgerFile.dictionary[code];
+        addEmployeeToColumnsDictionary(columns, entry.id, getLedgerFileString(ledgerFile, entry.firstName), getLedgerFileString(ledgerFile, entry.lastName));
+    }
+
+    // The payment columns have exactly the same layout in the file as in memory, so they just get copied as whole blocks
+    const size_t paymentsAmount = header.paymentsAmount;
+    columns.hoursWorked.append(ledgerFile.hoursWorked, paymentsAmount);
+    columns.regRates.append(ledgerFile.regRates, paymentsAmount);
+    columns.employeeCodes.append(ledgerFile.employeeCodes, paymentsAmount);
+    columns.payDates.append(ledgerFile.payDates, paymentsAmount);
+    columns.payrollPolicies.append(ledgerFile.payrollPolicies, paymentsAmount);
+
+    // (their payroll policies, & the amounts of payments of each one, were already checked when opening the file)
+    copy(begin(header.paymentsAmountsByPolicy), end(header.paymentsAmountsByPolicy), columns.paymentsAmountsByPolicy);
+
+    // The per-employee index is rebuilt from the codes (a code out of the dictionary means a corrupted file, so that payment gets left out of the index)
+    vector<vector<size_t>> positionsByCode(columns.employeeIds.size());
+    for (size_t position = 0; position < paymentsAmount; position++) {
+        if (const uint32_t code = columns.employeeCodes[position]; code < positionsByCode.size()) positionsByCode[code].push_back(position);
+    }
+    for (size_t code = 0; code < positionsByCode.size(); code++) {
+        if (!positionsByCode[code].empty()) paymentLedger.paymentPositionsByEmployeeId.emplace(getEmployeeIdOfCode(columns, static_cast<uint32_t>(code)), move(positionsByCode[code]));
+    }
+
+    // & the company's running report was saved along with the payments, so it does not need to be recomputed either (unlike the pay dates' additions)
+    paymentLedger.companyAdditionPayrollReport = getLedgerFilePayrollReport(ledgerFile);
+    paymentLedger.payDateIndex = createPayDateIndex(columns);
+}
+
+// Saves the whole system (employees & payments) into a given ledger file, replacing it atomically. Returns false if it could not be written
+bool saveLedgerFile(const string &path, const EmployeeRegistry &employeeRegistry, const PaymentLedger &paymentLedger, const uint64_t lastLogSequenceNumber) {
+    const PaymentColumns &columns = paymentLedger.columns;
+    const auto &employees = employeeRegistry.employees;
+    const size_t paymentsAmount = columns.size();
+
+    // Rounds up a given offset to the next multiple of 8
+    const auto alignTo8 = [](const uint64_t offset) { return (offset + 7) / 8 * 8; };
+
+    // First the layout: where each section starts
+    LedgerFileHeader header {};
+    memcpy(header.magic, LEDGER_FILE_MAGIC, sizeof(LEDGER_FILE_MAGIC));
+    header.version = LEDGER_FILE_VERSION;
+    header.headerSize = sizeof(LedgerFileHeader);
+    header.employeesAmount = employees.size();
+    header.dictionaryEntriesAmount = columns.employeeIds.size();
+    header.paymentsAmount = paymentsAmount;
+    header.employeesOffset = alignTo8(sizeof(LedgerFileHeader));
+    header.dictionaryOffset = header.employeesOffset + employees.size() * sizeof(LedgerFileEmployee);
+    header.hoursWorkedOffset = header.dictionaryOffset + columns.employeeIds.size() * sizeof(LedgerFileDictionaryEntry);
+    header.regRatesOffset = header.hoursWorkedOffset + paymentsAmount * sizeof(double);
+    header.employeeCodesOffset = header.regRatesOffset + paymentsAmount * sizeof(double);
+    header.payDatesOffset = header.employeeCodesOffset + paymentsAmount * sizeof(uint32_t);
+    header.payrollPoliciesOffset = header.payDatesOffset + paymentsAmount * sizeof(int32_t);
+    header.stringTableOffset = alignTo8(header.payrollPoliciesOffset + paymentsAmount * sizeof(PayrollPolicy));
+    header.lastLogSequenceNumber = lastLogSequenceNumber;
+    copy(begin(columns.paymentsAmountsByPolicy), end(columns.paymentsAmountsByPolicy), header.paymentsAmountsByPolicy);
+
+    const PayrollReport &report = paymentLedger.companyAdditionPayrollReport;
+    header.reportPaymentsAmount = report.paymentsAmount;
+    header.reportRegHours = report.regHours;
+    header.reportOtHours = report.otHours;
+    header.reportRegPayCents = report.regPay.cents;
+    header.reportOtPayCents = report.otPay.cents;
+    header.reportFicaCents = report.fica.cents;
+    header.reportSocSecCents = report.socSec.cents;
+
+    // The fixed width records, whose strings get placed one after the other inside the string table
+    uint64_t stringTableSize = 0;
+    const auto placeString = [&](const string_view aString) {
+        const LedgerFileString fileString {.offset = stringTableSize, .length = aString.size()};
+        stringTableSize += aString.size();
+        return fileString;
+    };
+    vector<LedgerFileEmployee> fileEmployees;
+    fileEmployees.reserve(employees.size());
+    for (const Employee &employee: employees) {
+        fileEmployees.push_back(LedgerFileEmployee {.id = employee.id, .firstName = placeString(employee.firstName), .lastName = placeString(employee.lastName), .regRate = employee.regRate,
+                                                    .payrollPolicy = employee.payrollPolicy, .reserved = {}});
+    }
+    vector<LedgerFileDictionaryEntry> fileDictionary;
+    fileDictionary.reserve(columns.employeeIds.size());
+    for (size_t code = 0; code < columns.employeeIds.size(); code++) {
+        const auto employeeCode = static_cast<uint32_t>(code);
+        fileDictionary.push_back(LedgerFileDictionaryEntry {.id = getEmployeeIdOfCode(columns, employeeCode), .firstName = placeString(getEmployeeFirstNameOfCode(columns, employeeCode)),
+                                                            .lastName = placeString(getEmployeeLastNameOfCode(columns, employeeCode))});
+    }
+    header.stringTableSize = stringTableSize;
+
+    // Everything gets written into a temporary file first, which then replaces the previous one (so a crash never leaves a half written ledger behind)
+    const string temporaryPath = path + ".tmp";
+    {
+        ofstream file(temporaryPath, ios::binary | ios::trunc);
+        const auto writeBytes = [&](const void *data, const size_t bytesAmount) { file.write(static_cast<const char *>(data), static_cast<streamsize>(bytesAmount)); };
+        const auto padTo = [&](const uint64_t offset) {
+            constexpr char zeros[8] {};
+            writeBytes(zeros, offset - static_cast<uint64_t>(file.tellp()));
+        };
+
+        writeBytes(&header, sizeof(header));
+        padTo(header.employeesOffset);
+        writeBytes(fileEmployees.data(), fileEmployees.size() * sizeof(LedgerFileEmployee));
+        writeBytes(fileDictionary.data(), fileDictionary.size() * sizeof(LedgerFileDictionaryEntry));
+        for (size_t chunk = 0; chunk < columns.hoursWorked.chunksAmount(); chunk++) writeBytes(columns.hoursWorked.chunkData(chunk), columns.hoursWorked.chunkSize(chunk) * sizeof(double));
+        for (size_t chunk = 0; chunk < columns.regRates.chunksAmount(); chunk++) writeBytes(columns.regRates.chunkData(chunk), columns.regRates.chunkSize(chunk) * sizeof(double));
+        for (size_t chunk = 0; chunk < columns.employeeCodes.chunksAmount(); chunk++) writeBytes(columns.employeeCodes.chunkData(chunk), columns.employeeCodes.chunkSize(chunk) * sizeof(uint32_t));
+        for (size_t chunk = 0; chunk < columns.payDates.chunksAmount(); chunk++) writeBytes(columns.payDates.chunkData(chunk), columns.payDates.chunkSize(chunk) * sizeof(int32_t));
+        for (size_t chunk = 0; chunk < columns.payrollPolicies.chunksAmount(); chunk++) {
+            writeBytes(columns.payrollPolicies.chunkData(chunk), columns.payrollPolicies.chunkSize(chunk) * sizeof(PayrollPolicy));
+        }
+        padTo(header.stringTableOffset);
+        for (const Employee &employee: employees) {
+            for (const string *aString: {&employee.firstName, &employee.lastName}) writeBytes(aString->data(), aString->size());
+        }
+        for (size_t code = 0; code < columns.employeeIds.size(); code++) {
+            const auto employeeCode = static_cast<uint32_t>(code);
+            for (const string_view aString: {getEmployeeFirstNameOfCode(columns, employeeCode), getEmployeeLastNameOfCode(columns, employeeCode)}) {
+                writeBytes(aString.data(), aString.size());
+            }
+        }
+
+        file.close();
+        if (!file) return false;
+    }
+
+    // The snapshot's bytes must be on disk before the rename makes it the ledger file, & the rename itself before the caller empties the log that could rebuild it
+    if (!syncFileToDisk(temporaryPath)) return false;
+    error_code errorCode;
+    filesystem::rename(temporaryPath, path, errorCode);
+    return !errorCode && syncParentDirectoryToDisk(path);
+}
+
+// Syncs to disk the contents of the (already written & closed) file at a given path. Returns false if it could not be synced
+bool syncFileToDisk(const string &path) {
+#ifndef _WIN32
+    const int fileDescriptor = open(path.c_str(), O_RDONLY);
+    if (fileDescriptor < 0) return false;
+    const bool isSynced = fsync(fileDescriptor) == 0;
+    close(fileDescriptor);
+#else
+    const int fileDescriptor = _open(path.c_str(), _O_RDWR | _O_BINARY);
+    if (fileDescriptor < 0) return false;
+    const bool isSynced = _commit(fileDescriptor) == 0;
+    _close(fileDescriptor);
+#endif
+    return isSynced;
+}
+
+// Syncs to disk the directory holding the file at a given path, so a file just renamed inside it survives a power loss. Returns false if it could not be synced
+bool syncParentDirectoryToDisk(const string &path) {
+#ifndef _WIN32
+    const string directory = filesystem::path(path).parent_path().string();
+    const int fileDescriptor = open(directory.empty() ? "." : directory.c_str(), O_RDONLY | O_DIRECTORY);
+    if (fileDescriptor < 0) return false;
+    const bool isSynced = fsync(fileDescriptor) == 0;
+    close(fileDescriptor);
+    return isSynced;
+#else
+    (void) path;
+    return true; // A directory can't be synced on Windows, where NTFS already journals the renames
+#endif
+}
+
+// Prints on the terminal both PayrollReports, addition & average, of the whole company, straight from a given ledger file (without loading it). Returns false if there is no valid ledger file to print them from
+bool printLedgerFileCompanyPayrollReports(const string &path, ThreadPool &threadPool) {
+    MappedLedgerFile ledgerFile;
+    if (openLedgerFile(path, ledgerFile) != LEDGER_FILE_OPENED) {
+        cerr << "There is no valid ledger file at " << path << "." << endl;
+        return false;
+    }
+    if (ledgerFile.header->paymentsAmount == 0) {
+        cout << "The ledger file " << path << " has no payments yet." << endl;
+        return true;
+    }
+
+#ifdef PAYROLL_VERIFY_AGGREGATES
+    // When verifying, the report saved in the header gets compared with the one rebuilt from the mapped columns (they add up in different orders, but the money adds up exactly)
+    const PayrollReport savedReport = getLedgerFilePayrollReport(ledgerFile);
+    const PayrollReport rebuiltReport = createAdditionPayrollReport(ledgerFile, threadPool);
+    if (savedReport.paymentsAmount != rebuiltReport.paymentsAmount || savedReport.regPay != rebuiltReport.regPay || savedReport.otPay != rebuiltReport.otPay ||
+        savedReport.fica != rebuiltReport.fica || savedReport.socSec != rebuiltReport.socSec) {
+        cerr << "The PayrollReport saved in the ledger file does not match its payments." << endl;
+        abort();
+    }
+#endif
+
+    // The payment columns get aggregated right where they are mapped, with all the report workers
+    const PayrollReport additionPayrollReport = createAdditionPayrollReport(ledgerFile, threadPool);
+    const PayrollReport averagePayrollReport = createAveragePayrollReportFromAddition(additionPayrollReport);
+
+    cout << fixed << setprecision(2); // Just like in the interactive mode, where the prompts leave it set
+    cout << "-----------------------------------------------------------------" << endl;
+    cout << "           C O M P A N Y   P A Y R O L L   R E P O R T           " << endl;
+    cout << "-----------------------------------------------------------------" << endl;
+    printCompanyPayrollReports(additionPayrollReport, averagePayrollReport);
+    return true;
+}
+
+// Computes the CRC-32 checksum of a given amount of bytes, continuing a given previous checksum
+uint32_t computeCrc32(const char *bytes, const size_t bytesAmount, const uint32_t previousChecksum) {
+    // The table of the (reflected) polynomial gets built only once, the first time
+    static const auto table = []() {
+        array<uint32_t, 256> table {};
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t value = i;
+            for (int bit = 0; bit < 8; bit++) value = value & 1 ? 0xEDB88320u ^ (value >> 1) : value >> 1;
+            table[i] = value;
+        }
+        return table;
+    }();
+
+    uint32_t checksum = ~previousChecksum;
+    for (size_t i = 0; i < bytesAmount; i++) checksum = table[(checksum ^ static_cast<uint8_t>(bytes[i])) & 0xFF] ^ (checksum >> 8);
+    return ~checksum;
+}
+
+// Records in a given WriteAheadLog the addition of a given Employee structure variable
+void logEmployeeAddition(WriteAheadLog &writeAheadLog, const Employee &employee) {
+    string payload;
+    appendLogEmployeeId(payload, employee.id);
+    for (const string *aString: {&employee.firstName, &employee.lastName}) appendLogString(payload, *aString);
+    appendLogDouble(payload, employee.regRate);
+    appendLogPayrollPolicy(payload, employee.payrollPolicy);
+    writeAheadLog.append(EMPLOYEE_ADDED, payload);
+}
+
+// Records in a given WriteAheadLog the deletion of an employee, given its id
+void logEmployeeDeletion(WriteAheadLog &writeAheadLog, const EmployeeId &employeeId) {
+    string payload;
+    appendLogEmployeeId(payload, employeeId);
+    writeAheadLog.append(EMPLOYEE_DELETED, payload);
+}
+
+// Records in a given WriteAheadLog the addition of a given Payment structure variable
+void logPaymentAddition(WriteAheadLog &writeAheadLog, const Payment &payment) {
+    // The whole payment gets recorded (not only its employee's id), so replaying it never depends on the employee being still there
+    string payload;
+    appendLogEmployeeId(payload, payment.employeeId);
+    for (const string_view aString: {payment.firstName, payment.lastName}) appendLogString(payload, aString);
+    appendLogDouble(payload, payment.hoursWorked);
+    appendLogDouble(payload, payment.regRate);
+    appendLogInt32(payload, payment.payDate);
+    appendLogPayrollPolicy(payload, payment.payrollPolicy);
+    writeAheadLog.append(PAYMENT_ADDED, payload);
+}
+
+// Appends a given string to a given log record's payload, preceded by its length
+void appendLogString(string &payload, const string_view aString) {
+    const auto length = static_cast<uint32_t>(aString.size());
+    payload.append(reinterpret_cast<const char *>(&length), sizeof(length));
+    payload.append(aString);
+}
+
+// Appends a given double to a given log record's payload
+void appendLogDouble(string &payload, const double value) {
+    payload.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+// Appends a given 32 bits integer to a given log record's payload
+void appendLogInt32(string &payload, const int32_t value) {
+    payload.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+// Appends a given employee's id to a given log record's payload, as its 16 bytes
+void appendLogEmployeeId(string &payload, const EmployeeId &employeeId) {
+    payload.append(reinterpret_cast<const char *>(&employeeId.high), sizeof(employeeId.high));
+    payload.append(reinterpret_cast<const char *>(&employeeId.low), sizeof(employeeId.low));
+}
+
+// Appends a given payroll policy to a given log record's payload, as a single byte
+void appendLogPayrollPolicy(string &payload, const PayrollPolicy payrollPolicy) {
+    payload.push_back(static_cast<char>(payrollPolicy));
+}
+
+// Reads the next string from a given log record's payload, advancing a given position. Returns false if the payload ends before it does
+bool readLogString(const string &payload, size_t &position, string &aString) {
+    uint32_t length;
+    if (payload.size() - position < sizeof(length)) return false;
+    memcpy(&length, payload.data() + position, sizeof(length));
+    position += sizeof(length);
+    if (payload.size() - position < length) return false;
+    aString.assign(payload, position, length);
+    position += length;
+    return true;
+}
+
+// Reads the next double from a given log record's payload, advancing a given position. Returns false if the payload ends before it does
+bool readLogDouble(const string &payload, size_t &position, double &value) {
+    if (payload.size() - position < sizeof(value)) return false;
+    memcpy(&value, payload.data() + position, sizeof(value));
+    position += sizeof(value);
+    return true;
+}
+
+// Reads the next 32 bits integer from a given log record's payload, advancing a given position. Returns false if the payload ends before it does
+bool readLogInt32(const string &payload, size_t &position, int32_t &value) {
+    if (payload.size() - position < sizeof(value)) return false;
+    memcpy(&value, payload.data() + position, sizeof(value));
+    position += sizeof(value);
+    return true;
+}
+
+// Reads the next employee's id from a given log record's payload, advancing a given position. Returns false if the payload ends before it does
+bool readLogEmployeeId(const string &payload, size_t &position, EmployeeId &employeeId) {
+    if (payload.size() - position < sizeof(employeeId.high) + sizeof(employeeId.low)) return false;
+    memcpy(&employeeId.high, payload.data() + position, sizeof(employeeId.high));
+    memcpy(&employeeId.low, payload.data() + position + sizeof(employeeId.high), sizeof(employeeId.low));
+    position += sizeof(employeeId.high) + sizeof(employeeId.low);
+    return true;
+}
+
+// Reads the next payroll policy from a given log record's payload, advancing a given position. Returns false if the payload ends before it does, or it's not a known policy
+bool readLogPayrollPolicy(const string &payload, size_t &position, PayrollPolicy &payrollPolicy) {
+    if (payload.size() - position < sizeof(payrollPolicy)) return false;
+    const auto value = static_cast<uint8_t>(payload[position]);
+    if (value >= PAYROLL_POLICIES_AMOUNT) return false;
+    payrollPolicy = static_cast<PayrollPolicy>(value);
+    position += sizeof(payrollPolicy);
+    return true;
+}
+
+// Applies a given log record to the references of a given EmployeeRegistry & PaymentLedger. Returns false if its payload is not valid
+bool applyLogRecord(const LogRecordHeader &recordHeader, const string &payload, EmployeeRegistry &employeeRegistry, PaymentLedger &paymentLedger) {
+    size_t position = 0;
+    switch (recordHeader.type) {
+        case EMPLOYEE_ADDED: {
+            Employee employee;
+            if (!readLogEmployeeId(payload, position, employee.id) || !readLogString(payload, position, employee.firstName) ||
+                !readLogString(payload, position, employee.lastName) || !readLogDouble(payload, position, employee.regRate) ||
+                !readLogPayrollPolicy(payload, position, employee.payrollPolicy)) return false;
+            if (!existEmployee(employeeRegistry, employee.id)) insertEmployee(employeeRegistry, move(employee));
+            return true;
+        }
+        case EMPLOYEE_DELETED: {
+            EmployeeId employeeId;
+            if (!readLogEmployeeId(payload, position, employeeId)) return false;
+            deleteEmployeById(employeeRegistry, employeeId);
+            return true;
+        }
+        case PAYMENT_ADDED: {
+            string firstName, lastName; // The payment only views them
+            Payment payment;
+            if (!readLogEmployeeId(payload, position, payment.employeeId) || !readLogString(payload, position, firstName) || !readLogString(payload, position, lastName) ||
+                !readLogDouble(payload, position, payment.hoursWorked) || !readLogDouble(payload, position, payment.regRate) || !readLogInt32(payload, position, payment.payDate) ||
+                !readLogPayrollPolicy(payload, position, payment.payrollPolicy)) return false;
+            payment.firstName = firstName;
+            payment.lastName = lastName;
+            insertPayment(paymentLedger, payment);
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+// Applies the records of a given write-ahead log file newer than a given sequence number to the references of a given EmployeeRegistry & PaymentLedger.
+// Stops at the first torn or corrupted record, cutting the log there. Returns how many records were applied, & leaves the last sequence number found in the given reference
+size_t replayWriteAheadLog(const string &path, const uint64_t snapshotSequenceNumber, EmployeeRegistry &employeeRegistry, PaymentLedger &paymentLedger, uint64_t &lastSequenceNumber) {
+    PAYROLL_TIME_OPERATION(REPLAY_WRITE_AHEAD_LOG_OPERATION);
+    ifstream file(path, ios::binary);
+    if (!file) return 0; // Not an error: there is just nothing logged yet
+    error_code errorCode;
+    const uint64_t fileSize = filesystem::file_size(path, errorCode);
+    if (errorCode) return 0;
+
+    size_t appliedRecords = 0;
+    uint64_t validBytes = 0; // Where the last valid record ends
+    uint64_t previousSequenceNumber = 0;
+    LogRecordHeader recordHeader {};
+    string payload;
+    while (file.read(reinterpret_cast<char *>(&recordHeader), sizeof(recordHeader))) {
+        // A torn or garbage header may claim a payload longer than what's left of the file (or than any record ever is), so it never gets allocated
+        if (recordHeader.payloadLength > MAX_LOG_RECORD_PAYLOAD_LENGTH || recordHeader.payloadLength > fileSize - validBytes - sizeof(recordHeader)) break;
+        payload.resize(recordHeader.payloadLength);
+        if (!file.read(payload.data(), static_cast<streamsize>(payload.size()))) break; // Torn by a crash while being written
+
+        // The checksum was computed with its own field set to 0
+        LogRecordHeader checkedHeader = recordHeader;
+        checkedHeader.checksum = 0;
+        const uint32_t checksum = computeCrc32(payload.data(), payload.size(), computeCrc32(reinterpret_cast<const char *>(&checkedHeader), sizeof(checkedHeader)));
+        if (checksum != recordHeader.checksum || recordHeader.sequenceNumber <= previousSequenceNumber) break; // The sequence numbers only grow
+        previousSequenceNumber = recordHeader.sequenceNumber;
+
+        // The records already folded into the snapshot are just skipped (the log could not be emptied right after saving it)
+        if (recordHeader.sequenceNumber > snapshotSequenceNumber) {
+            if (!applyLogRecord(recordHeader, payload, employeeRegistry, paymentLedger)) break;
+            appliedRecords++;
+        }
+        lastSequenceNumber = max(lastSequenceNumber, recordHeader.sequenceNumber);
+        validBytes += sizeof(recordHeader) + payload.size();
+    }
+
+    // Anything after the last valid record could never be trusted, so it gets cut off (the new records will follow the valid ones)
+    file.close();
+    if (validBytes < fileSize) {
+        cerr << "The write-ahead log " << path << " had a torn or corrupted record, so it was cut right before it." << endl;
+        filesystem::resize_file(path, validBytes, errorCode);
+    }
+    return appliedRecords;
+}
+
+// Folds a given WriteAheadLog into a snapshot of the whole system saved into a given ledger file, & empties the log. Returns false if the snapshot could not be saved
+bool compactWriteAheadLog(const string &ledgerFilePath, WriteAheadLog &writeAheadLog, const EmployeeRegistry &employeeRegistry, const PaymentLedger &paymentLedger) {
+    PAYROLL_TIME_OPERATION(COMPACT_WRITE_AHEAD_LOG_OPERATION);
+    // The snapshot remembers the last record it includes, so if we crash before emptying the log, those records never get replayed twice.
+    // The log only gets emptied once the snapshot (& its rename) are synced to disk, so there is always one of them to recover from
+    writeAheadLog.flush();
+    if (!saveLedgerFile(ledgerFilePath, employeeRegistry, paymentLedger, writeAheadLog.nextSequenceNumber - 1)) return false;
+    writeAheadLog.truncate();
+    return true;
+}
+
+// Opens (or creates) the log file at the given path, & starts the background flusher (unless the given latency is 0)
+WriteAheadLog::WriteAheadLog(const string &path, const size_t groupCommitRecords, const unsigned groupCommitLatencyMs)
+    : path(path), file(fopen(path.c_str(), "ab")), groupCommitRecords(max<size_t>(1, groupCommitRecords)), groupCommitLatency(groupCommitLatencyMs) {
+    if (file != nullptr && groupCommitLatency.count() > 0) flusher = thread([this]() { flusherLoop(); });
+}
+
+// Stops the background flusher, & syncs to disk whatever was still pending
+WriteAheadLog::~WriteAheadLog() {
+    {
+        lock_guard<mutex> lock(pendingMutex);
+        stopping = true;
+    }
+    recordsPending.notify_all();
+    if (flusher.joinable()) flusher.join();
+    flush();
+    if (file != nullptr) fclose(file);
+}
+
+// Appends a record of the given type & payload, with the next sequence number. It may get synced to disk a bit later (see above)
+void WriteAheadLog::append(const LogRecordType type, const string &payload) {
+    LogRecordHeader recordHeader {.payloadLength = static_cast<uint32_t>(payload.size()), .checksum = 0, .sequenceNumber = nextSequenceNumber++, .type = type, .reserved = 0};
+    recordHeader.checksum = computeCrc32(payload.data(), payload.size(), computeCrc32(reinterpret_cast<const char *>(&recordHeader), sizeof(recordHeader)));
+    recordsAmount++;
+    PAYROLL_COUNT(LOG_RECORDS_APPENDED_COUNTER, 1);
+
+    size_t pendingRecords;
+    {
+        lock_guard<mutex> lock(pendingMutex);
+        pendingBytes.append(reinterpret_cast<const char *>(&recordHeader), sizeof(recordHeader));
+        pendingBytes.append(payload);
+        pendingRecords = ++pendingRecordsAmount;
+    }
+
+    // Without a flusher, each record gets synced right away. With it, the flusher only gets woken up by the first record of a group (to start counting
+    // its latency) & by the one that fills it
+    if (!flusher.joinable()) flush();
+    else if (pendingRecords == 1 || pendingRecords == groupCommitRecords) recordsPending.notify_one();
+}
+
+// Syncs to disk right now all the records appended so far
+void WriteAheadLog::flush() {
+    lock_guard<mutex> fileLock(fileMutex); // Taken first, so a group being written by the flusher is on disk too once this returns
+    string bytes;
+    {
+        lock_guard<mutex> lock(pendingMutex);
+        bytes.swap(pendingBytes);
+        pendingRecordsAmount = 0;
+    }
+    if (!bytes.empty()) writeAndSync(bytes);
+}
+
+// Flushes & empties the log (once all its records are safely folded into a snapshot)
+void WriteAheadLog::truncate() {
+    flush();
+    lock_guard<mutex> fileLock(fileMutex);
+    if (file != nullptr) fclose(file);
+    file = fopen(path.c_str(), "wb");
+    recordsAmount = 0;
+}
+
+// What the background flusher does, until the log gets destroyed
+void WriteAheadLog::flusherLoop() {
+    unique_lock<mutex> lock(pendingMutex);
+    while (true) {
+        // Sleeps until a group starts, & then until it gets full or its latency expires
+        recordsPending.wait(lock, [&]() { return stopping || pendingRecordsAmount > 0; });
+        if (stopping) return; // The destructor flushes whatever is left
+        recordsPending.wait_for(lock, groupCommitLatency, [&]() { return stopping || pendingRecordsAmount >= groupCommitRecords; });
+
+        lock.unlock();
+        flush();
+        lock.lock();
+    }
+}
+
+// Writes the given bytes at the end of the log file, & syncs it to disk
+void WriteAheadLog::writeAndSync(const string &bytes) {
+    PAYROLL_TIME_OPERATION(SYNC_WRITE_AHEAD_LOG_OPERATION);
+    if (file == nullptr) return;
+    const bool isWritten = fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size() && fflush(file) == 0;
+#ifndef _WIN32
+    const bool isSynced = fsync(fileno(file)) == 0;
+#else
+    const bool isSynced = _commit(_fileno(file)) == 0;
+#endif
+    if (!isWritten || !isSynced) cerr << "The write-ahead log " << path << " could not be synced to disk." << endl;
+    syncsAmount++;
+}
+
+// Reads a given CSV file by blocks, calling a given handler with the fields of each one of its non empty lines (& the line's number). Returns false if it can not be opened
+template<typename CsvRowHandler>
+bool streamCsvFile(const string &path, CsvRowHandler handleRow) {
+    FILE *file = fopen(path.c_str(), "rb");
+    if (file == nullptr) return false;
+
+    // A single buffer for the whole file: each block gets appended after the unfinished line left by the previous one (no allocations once it's big enough)
+    vector<char> buffer(CSV_READ_BLOCK_SIZE);
+    vector<string_view> fields;
+    size_t carriedBytes = 0; // The beginning of a line, still waiting for its end
+    size_t lineNumber = 0;
+
+    // Splits a given complete line (without its line break), & hands it over
+    const auto processLine = [&](string_view line) {
+        lineNumber++;
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1); // Windows line breaks
+        if (line.empty()) return;
+        const bool isWellFormed = splitCsvLine(line, fields);
+        PAYROLL_COUNT(CSV_ROWS_READ_COUNTER, 1);
+        handleRow(lineNumber, fields, isWellFormed);
+    };
+
+    while (true) {
+        if (buffer.size() - carriedBytes < CSV_READ_BLOCK_SIZE) buffer.resize(carriedBytes + CSV_READ_BLOCK_SIZE); // A line longer than a whole block
+        const size_t readBytes = fread(buffer.data() + carriedBytes, 1, CSV_READ_BLOCK_SIZE, file);
+        const size_t availableBytes = carriedBytes + readBytes;
+        if (readBytes == 0) {
+            if (carriedBytes > 0) processLine(string_view(buffer.data(), carriedBytes)); // The last line had no line break
+            break;
+        }
+
+        // Every complete line gets processed right where it is in the buffer
+        const char *lineStart = buffer.data();
+        const char *const end = buffer.data() + availableBytes;
+        while (const auto *lineEnd = static_cast<const char *>(memchr(lineStart, '\n', end - lineStart))) {
+            processLine(string_view(lineStart, lineEnd - lineStart));
+            lineStart = lineEnd + 1;
+        }
+
+        // & the unfinished one gets moved to the beginning, to be completed by the next block
+        carriedBytes = end - lineStart;
+        memmove(buffer.data(), lineStart, carriedBytes);
+    }
+
+    fclose(file);
+    return true;
+}
+
+// Splits a given CSV line into the reference of a given vector of fields (views into the line, without their quotes). Returns false if its quotes are not balanced
+bool splitCsvLine(const string_view line, vector<string_view> &fields) {
+    fields.clear();
+    size_t position = 0;
+    while (true) {
+        if (position < line.size() && line[position] == '"') {
+            // A quoted field ends at the first quote that is not an escaped one (""), which must be followed by a comma or by the end of the line
+            size_t closingQuote = position + 1;
+            while (true) {
+                closingQuote = line.find('"', closingQuote);
+                if (closingQuote == string_view::npos) return false;
+                if (closingQuote + 1 < line.size() && line[closingQuote + 1] == '"') closingQuote += 2;
+                else break;
+            }
+            fields.push_back(line.substr(position + 1, closingQuote - position - 1));
+            position = closingQuote + 1;
+            if (position < line.size() && line[position] != ',') return false;
+        } else {
+            const size_t comma = min(line.find(',', position), line.size());
+            fields.push_back(line.substr(position, comma - position));
+            position = comma;
+        }
+
+        if (position >= line.size()) return true;
+        position++; // Skips the comma
+    }
+}
+
+// Assigns a given CSV field to the reference of a given string, turning its escaped quotes ("") into single ones
+void assignCsvField(string &target, const string_view field) {
+    target.assign(field); // Reuses the string's own memory, whenever it's enough
+    for (size_t quote = target.find("\"\""); quote != string::npos; quote = target.find("\"\"", quote + 1)) target.erase(quote, 1);
+}
+
+// Parses a given CSV field as a finite floating point number, into the reference of a given double. Returns false if the whole field is not such a number
+bool parseCsvDouble(string_view field, double &value) {
+    // Surrounding blanks & a leading plus sign are allowed (from_chars accepts neither)
+    while (!field.empty() && field.front() == ' ') field.remove_prefix(1);
+    while (!field.empty() && field.back() == ' ') field.remove_suffix(1);
+    const bool hasPlusSign = !field.empty() && field.front() == '+';
+    if (hasPlusSign) field.remove_prefix(1);
+    if (field.empty() || (hasPlusSign && field.front() == '-')) return false; // Like "+-5", which is no number at all
+
+    const auto [end, errorCode] = from_chars(field.data(), field.data() + field.size(), value);
+    return errorCode == errc() && end == field.data() + field.size() && isfinite(value);
+}
+
+// Determines if a given CSV line is just the header with the given column names
+bool isCsvHeader(const vector<string_view> &fields, const vector<string_view> &columnNames) {
+    return fields == columnNames;
+}
+
+// Reports a rejected row of a given CSV import (only the first ones get printed)
+void reportCsvRowError(CsvImportReport &importReport, const size_t lineNumber, const string &message) {
+    if (importReport.rejectedRows++ < MAX_REPORTED_CSV_ERRORS) cerr << importReport.path << ":" << lineNumber << ": " << message << endl;
+}
+
+// Imports into the reference of a given EmployeeRegistry the employees of a given CSV file (id,first_name,last_name,reg_rate[,payroll_policy]; an empty id gets a new one)
+CsvImportReport importEmployeesCsv(const string &path, EmployeeRegistry &employeeRegistry) {
+    PAYROLL_TIME_OPERATION(IMPORT_EMPLOYEES_CSV_OPERATION);
+    CsvImportReport importReport {.path = path};
+    const vector<string_view> columnNames {"id", "first_name", "last_name", "reg_rate", "payroll_policy"}; // The payroll policy is optional (the standard one, if it's missing)
+    const vector<string_view> requiredColumnNames(columnNames.begin(), columnNames.end() - 1);
+    const auto startTime = chrono::steady_clock::now();
+
+    const bool isOpened = streamCsvFile(path, [&](const size_t lineNumber, const vector<string_view> &fields, const bool isWellFormed) {
+        if (lineNumber == 1 && (isCsvHeader(fields, columnNames) || isCsvHeader(fields, requiredColumnNames))) return;
+
+        // The same validations as when an employee gets typed in the menu, plus the uniqueness of the given ids
+        double regRate;
+        PayrollPolicy payrollPolicy = STANDARD_PAYROLL_POLICY;
+        if (!isWellFormed || (fields.size() != columnNames.size() && fields.size() != requiredColumnNames.size())) {
+            return reportCsvRowError(importReport, lineNumber, "expected 4 or 5 fields: id,first_name,last_name,reg_rate[,payroll_policy]");
+        }
+        if (fields[1].empty() || fields[2].empty()) return reportCsvRowError(importReport, lineNumber, "the first & last names can not be empty");
+        if (!parseCsvDouble(fields[3], regRate)) return reportCsvRowError(importReport, lineNumber, "the regular rate is not a number");
+        if (regRate < MIN_HOURLY_WAGE || MAX_HOURLY_WAGE < regRate) return reportCsvRowError(importReport, lineNumber, "the regular rate must be between " + monetizeDouble(MIN_HOURLY_WAGE) + " & " + monetizeDouble(MAX_HOURLY_WAGE));
+
+        if (fields.size() == columnNames.size() && !parsePayrollPolicy(fields[4], payrollPolicy)) {
+            return reportCsvRowError(importReport, lineNumber, "the payroll policy must be " + string(PAYROLL_RULES[STANDARD_PAYROLL_POLICY].name) + " or " +
+                                                                   string(PAYROLL_RULES[OVERTIME_EXEMPT_PAYROLL_POLICY].name));
+        }
+
+        Employee employee {.regRate = regRate, .payrollPolicy = payrollPolicy};
+        if (fields[0].empty()) employee.id = generateEmployeeId();
+        else if (!parseEmployeeId(fields[0], employee.id)) return reportCsvRowError(importReport, lineNumber, "the id is not a valid UUID (like bdc0a2fb-d39e-4242-9a0a-4e760153f18d)");
+        if (existEmployee(employeeRegistry, employee.id)) return reportCsvRowError(importReport, lineNumber, "there is already an employee with the id " + employeeIdToString(employee.id));
+        assignCsvField(employee.firstName, fields[1]);
+        assignCsvField(employee.lastName, fields[2]);
+        insertEmployee(employeeRegistry, move(employee));
+        importReport.importedRows++;
+    });
+
+    if (!isOpened) cerr << "The CSV file " << path << " could not be opened." << endl;
+    importReport.rejectedRows += !isOpened;
+    importReport.seconds = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+    return importReport;
+}
+
+// Imports into the reference of a given PaymentLedger the payments of a given CSV file (employee_id,hours_worked), for the current employees of a given EmployeeRegistry
+CsvImportReport importPaymentsCsv(const string &path, const EmployeeRegistry &employeeRegistry, PaymentLedger &paymentLedger) {
+    PAYROLL_TIME_OPERATION(IMPORT_PAYMENTS_CSV_OPERATION);
+    CsvImportReport importReport {.path = path};
+    const vector<string_view> columnNames {"employee_id", "hours_worked", "pay_date"}; // The pay date is optional (today's date, if it's missing)
+    const vector<string_view> requiredColumnNames(columnNames.begin(), columnNames.end() - 1);
+    const int32_t todaysDate = getTodaysDate();
+    Payment payment; // Reused by every row
+    EmployeeId employeeId;
+    const auto startTime = chrono::steady_clock::now();
+
+    const bool isOpened = streamCsvFile(path, [&](const size_t lineNumber, const vector<string_view> &fields, const bool isWellFormed) {
+        if (lineNumber == 1 && (isCsvHeader(fields, columnNames) || isCsvHeader(fields, requiredColumnNames))) return;
+
+        // The same validations as when a payment gets typed in the menu
+        double hoursWorked;
+        int32_t payDate = todaysDate;
+        if (!isWellFormed || (fields.size() != columnNames.size() && fields.size() != requiredColumnNames.size())) {
+            return reportCsvRowError(importReport, lineNumber, "expected 2 or 3 fields: employee_id,hours_worked[,pay_date]");
+        }
+        if (!parseEmployeeId(fields[0], employeeId)) return reportCsvRowError(importReport, lineNumber, "the employee's id is not a valid UUID");
+        const auto indexIterator = employeeRegistry.positionsById.find(employeeId);
+        if (indexIterator == employeeRegistry.positionsById.end()) return reportCsvRowError(importReport, lineNumber, "there is no current employee with the id " + employeeIdToString(employeeId));
+        if (!parseCsvDouble(fields[1], hoursWorked)) return reportCsvRowError(importReport, lineNumber, "the hours worked are not a number");
+        if (hoursWorked < 1 || MAX_HOURS_WORKED < hoursWorked) return reportCsvRowError(importReport, lineNumber, "the hours worked must be between 1 & " + to_string(MAX_HOURS_WORKED));
+        if (fields.size() == columnNames.size() && !parseIsoDate(fields[2], payDate)) return reportCsvRowError(importReport, lineNumber, "the pay date is not a valid date (YYYY-MM-DD)");
+
+        // The payment just views the employee's data (the registry does not change while importing payments)
+        const Employee &employee = employeeRegistry.employees[indexIterator->second];
+        payment.employeeId = employee.id;
+        payment.firstName = employee.firstName;
+        payment.lastName = employee.lastName;
+        payment.hoursWorked = hoursWorked;
+        payment.regRate = employee.regRate;
+        payment.payDate = payDate;
+        payment.payrollPolicy = employee.payrollPolicy;
+        insertPayment(paymentLedger, payment);
+        importReport.importedRows++;
+    });
+
+    if (!isOpened) cerr << "The CSV file " << path << " could not be opened." << endl;
+    importReport.rejectedRows += !isOpened;
+    importReport.seconds = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+    return importReport;
+}
+
+// Prints on the terminal the outcome of a given CSV import
+void printCsvImportReport(const CsvImportReport &importReport, const string &rowName) {
+    const double rowsPerSecond = importReport.seconds > 0 ? (importReport.importedRows + importReport.rejectedRows) / importReport.seconds : 0;
+    cout << "Imported " << humanizeUnsignedInteger(importReport.importedRows) << " " << rowName << (importReport.importedRows == 1 ? "" : "s") << " from " << importReport.path
+         << " in " << fixed << setprecision(3) << importReport.seconds << " s (" << humanizeUnsignedInteger(static_cast<unsigned long long>(rowsPerSecond)) << " rows/s)";
+    if (importReport.rejectedRows > 0) cout << ", rejecting " << humanizeUnsignedInteger(importReport.rejectedRows) << " row" << (importReport.rejectedRows == 1 ? "" : "s");
+    cout << "." << endl;
+}
+
+// Generates into the references of a given EmployeeRegistry & PaymentLedger a given SyntheticWorkload, drawing its employees & payments by blocks with the workers of a given ThreadPool
+WorkloadGenerationReport generateSyntheticWorkload(const SyntheticWorkload &workload, EmployeeRegistry &employeeRegistry, PaymentLedger &paymentLedger, ThreadPool &threadPool) {
+    PAYROLL_TIME_OPERATION(GENERATE_SYNTHETIC_WORKLOAD_OPERATION);
+    WorkloadGenerationReport generationReport {.seed = workload.seed};
+    const auto startTime = chrono::steady_clock::now();
+    constexpr string_view FIRST_NAMES[] = {"James", "Mary", "Robert", "Patricia", "John", "Jennifer", "Michael", "Linda", "David", "Elizabeth", "William", "Barbara",
+                                           "Richard", "Susan", "Joseph", "Jessica", "Thomas", "Karen", "Carlos", "Sarah", "Daniel", "Lisa", "Jose", "Maria"};
+    constexpr string_view LAST_NAMES[] = {"Smith", "Johnson", "Williams", "Brown", "Jones", "Garcia", "Miller", "Davis", "Rodriguez", "Martinez", "Hernandez", "Lopez",
+                                          "Gonzalez", "Wilson", "Anderson", "Thomas", "Taylor", "Moore", "Jackson", "Martin", "Lee", "Perez", "Thompson", "Ramos"};
+    const auto blocksAmount = [](const size_t amount) { return (amount + WORKLOAD_GENERATION_BLOCK_SIZE - 1) / WORKLOAD_GENERATION_BLOCK_SIZE; };
+
+    // Whatever is already loaded goes into the seed too, so generating again with the same seed adds new employees, instead of the very same ones
+    const uint64_t seed = deriveWorkloadSeed(deriveWorkloadSeed(workload.seed, employeeRegistry.size()), paymentLedger.size());
+    const int32_t firstPayDate = daysFromCivilDate(2023, 1, 6); // The generated pay dates are weekly, on the Fridays from this one on
+
+    // First the employees, each block from a seed of its own: common names (so many of them get shared), wage rates skewed towards the minimum,
+    // a share of them overtime-exempt & another one about to leave
+    const size_t employeesAmount = workload.employeesAmount;
+    vector<Employee> employees(employeesAmount);
+    vector<uint8_t> leavingFlags(employeesAmount); // Written by several threads at once (unlike the bits of a vector<bool>)
+    threadPool.runTasks(blocksAmount(employeesAmount), [&](const size_t block) {
+        mt19937_64 generator(deriveWorkloadSeed(deriveWorkloadSeed(seed, EMPLOYEES_WORKLOAD_STREAM), block));
+        const size_t lastEmployee = min(employeesAmount, (block + 1) * WORKLOAD_GENERATION_BLOCK_SIZE);
+        for (size_t i = block * WORKLOAD_GENERATION_BLOCK_SIZE; i < lastEmployee; i++) {
+            Employee &employee = employees[i];
+            employee.id = generateEmployeeId(generator);
+            employee.firstName = FIRST_NAMES[generator() % size(FIRST_NAMES)];
+            employee.lastName = LAST_NAMES[generator() % size(LAST_NAMES)];
+            const double rateFraction = drawFraction(generator);
+            employee.regRate = round((MIN_HOURLY_WAGE + (MAX_HOURLY_WAGE - MIN_HOURLY_WAGE) * rateFraction * rateFraction) * 100) / 100; // In whole cents
+            employee.payrollPolicy = drawFraction(generator) < workload.overtimeExemptShare ? OVERTIME_EXEMPT_PAYROLL_POLICY : STANDARD_PAYROLL_POLICY;
+            leavingFlags[i] = drawFraction(generator) < workload.churnShare;
+        }
+    });
+
+    // They get hired in order (an id already taken, by a current or an ex employee, just moves on to the next free one, so the outcome stays the same)
+    const size_t firstEmployeePosition = employeeRegistry.size();
+    vector<EmployeeId> leavingEmployeeIds;
+    employeeRegistry.positionsById.reserve(firstEmployeePosition + employeesAmount);
+    for (size_t i = 0; i < employeesAmount; i++) {
+        Employee &employee = employees[i];
+        while (existEmployee(employeeRegistry, employee.id) || paymentLedger.columns.employeeCodesById.count(employee.id) > 0) employee.id.low++;
+        if (leavingFlags[i]) leavingEmployeeIds.push_back(employee.id);
+        insertEmployee(employeeRegistry, move(employee));
+    }
+    generationReport.generatedEmployees = employeesAmount;
+
+    // Then the payments, also by blocks, in the order of their pay dates (the same amount of them every week). A few employees get most of them:
+    // the employee gets drawn as a squared fraction of all of them, so the i-th one receives them in proportion to 1 / sqrt(i)
+    const size_t paymentsAmount = workload.paymentsAmount;
+    vector<uint32_t> employeeIndexes(paymentsAmount);
+    vector<double> hoursWorked(paymentsAmount);
+    vector<double> regRates(paymentsAmount);
+    vector<int32_t> payDates(paymentsAmount);
+    vector<PayrollPolicy> payrollPolicies(paymentsAmount);
+    threadPool.runTasks(blocksAmount(paymentsAmount), [&](const size_t block) {
+        mt19937_64 generator(deriveWorkloadSeed(deriveWorkloadSeed(seed, PAYMENTS_WORKLOAD_STREAM), block));
+        const size_t lastPayment = min(paymentsAmount, (block + 1) * WORKLOAD_GENERATION_BLOCK_SIZE);
+        for (size_t i = block * WORKLOAD_GENERATION_BLOCK_SIZE; i < lastPayment; i++) {
+            const double employeeFraction = drawFraction(generator);
+            const auto employeeIndex = static_cast<uint32_t>(min(employeesAmount - 1, static_cast<size_t>(employeeFraction * employeeFraction * static_cast<double>(employeesAmount))));
+            const Employee &employee = employeeRegistry.employees[firstEmployeePosition + employeeIndex];
+
+            // Most weeks have between 20 & 40 hours (closer to 40 more often), & the ones with overtime go up to MAX_HOURS_WORKED (closer to 40 more often too), in quarters of an hour
+            const double firstFraction = drawFraction(generator), secondFraction = drawFraction(generator);
+            const double hours = drawFraction(generator) < GENERATED_OVERTIME_SHARE ? MAX_REG_HOURS + (MAX_HOURS_WORKED - MAX_REG_HOURS) * firstFraction * secondFraction
+                                                                                    : GENERATED_MIN_REGULAR_HOURS + (MAX_REG_HOURS - GENERATED_MIN_REGULAR_HOURS) * max(firstFraction, secondFraction);
+            employeeIndexes[i] = employeeIndex;
+            hoursWorked[i] = round(hours * 4) / 4;
+            regRates[i] = employee.regRate;
+            payDates[i] = firstPayDate + 7 * static_cast<int32_t>(i * GENERATED_PAY_PERIODS / paymentsAmount);
+            payrollPolicies[i] = employee.payrollPolicy;
+        }
+    });
+
+    // The dictionary codes (in the order of each employee's first payment), the company's running report & the per-employee index get built
+    // just like inserting the payments one by one would, so they end up exactly the same
+    PaymentColumns &columns = paymentLedger.columns;
+    const size_t firstPaymentPosition = columns.size();
+    constexpr uint32_t NO_CODE = UINT32_MAX;
+    vector<uint32_t> codesByEmployee(employeesAmount, NO_CODE);
+    vector<uint32_t> employeeCodes(paymentsAmount);
+    vector<vector<size_t>> positionsByEmployee(employeesAmount);
+    for (size_t i = 0; i < paymentsAmount; i++) {
+        const uint32_t employeeIndex = employeeIndexes[i];
+        if (codesByEmployee[employeeIndex] == NO_CODE) {
+            const Employee &employee = employeeRegistry.employees[firstEmployeePosition + employeeIndex];
+            codesByEmployee[employeeIndex] = addEmployeeToColumnsDictionary(columns, employee.id, employee.firstName, employee.lastName);
+        }
+        employeeCodes[i] = codesByEmployee[employeeIndex];
+        positionsByEmployee[employeeIndex].push_back(firstPaymentPosition + i);
+        addPaymentFiguresToPayrollReport(paymentLedger.companyAdditionPayrollReport, computePaymentFigures(hoursWorked[i], regRates[i], payrollPolicies[i]));
+        columns.paymentsAmountsByPolicy[payrollPolicies[i]]++;
+    }
+
+    // The columns get appended as whole blocks, & the pay dates' additions rebuilt from them
+    columns.hoursWorked.append(hoursWorked.data(), paymentsAmount);
+    columns.regRates.append(regRates.data(), paymentsAmount);
+    columns.employeeCodes.append(employeeCodes.data(), paymentsAmount);
+    columns.payDates.append(payDates.data(), paymentsAmount);
+    columns.payrollPolicies.append(payrollPolicies.data(), paymentsAmount);
+    for (size_t i = 0; i < employeesAmount; i++) {
+        if (!positionsByEmployee[i].empty()) paymentLedger.paymentPositionsByEmployeeId.emplace(employeeRegistry.employees[firstEmployeePosition + i].id, move(positionsByEmployee[i]));
+    }
+    paymentLedger.payDateIndex = createPayDateIndex(columns);
+    PAYROLL_COUNT(PAYMENTS_INSERTED_COUNTER, paymentsAmount);
+    generationReport.generatedPayments = paymentsAmount;
+
+    // Finally the churn: the leaving employees get deleted, just as through the menu (their payments stay, as the ones of ex employees)
+    for (const EmployeeId &employeeId: leavingEmployeeIds) deleteEmployeById(employeeRegistry, employeeId);
+    generationReport.deletedEmployees = leavingEmployeeIds.size();
+
+    generationReport.seconds = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+    return generationReport;
+}
+
+// Derives from a given seed & a given value a new seed, as unrelated to the given one as to the seeds derived from any other value (a SplitMix64 step)
+uint64_t deriveWorkloadSeed(const uint64_t seed, const uint64_t value) {
+    uint64_t mixedSeed = seed + (value + 1) * 0x9E3779B97F4A7C15ULL;
+    mixedSeed = (mixedSeed ^ (mixedSeed >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    mixedSeed = (mixedSeed ^ (mixedSeed >> 27)) * 0x94D049BB133111EBULL;
+    return mixedSeed ^ (mixedSeed >> 31);
+}
+
+// Draws from a given generator a fraction in [0, 1), the same one on every platform (unlike uniform_real_distribution)
+double drawFraction(mt19937_64 &generator) {
+    return static_cast<double>(generator() >> 11) * 0x1.0p-53; // The top 53 bits, as many as a double's mantissa holds
+}
+
+// Prints on the terminal the outcome of generating a synthetic workload
+void printWorkloadGenerationReport(const WorkloadGenerationReport &generationReport) {
+    const double paymentsPerSecond = generationReport.seconds > 0 ? static_cast<double>(generationReport.generatedPayments) / generationReport.seconds : 0;
+    cout << "Generated " << humanizeUnsignedInteger(generationReport.generatedEmployees) << " employee" << (generationReport.generatedEmployees == 1 ? "" : "s") << " ("
+         << humanizeUnsignedInteger(generationReport.deletedEmployees) << " of them deleted afterwards) & " << humanizeUnsignedInteger(generationReport.generatedPayments)
+         << " payment" << (generationReport.generatedPayments == 1 ? "" : "s") << " from the seed " << generationReport.seed << " in " << fixed << setprecision(3)
+         << generationReport.seconds << " s (" << humanizeUnsignedInteger(static_cast<unsigned long long>(paymentsPerSecond)) << " payments/s)." << endl;
+}
+
+// Reads into the reference of a given vector the what-if scenarios of a given CSV file (name,max_reg_hours,ot_multiplier,fica_rate,ss_med_rate; an empty rule keeps the current one)
+CsvImportReport readPayrollScenariosCsv(const string &path, vector<PayrollScenario> &scenarios) {
+    CsvImportReport importReport {.path = path};
+    const vector<string_view> columnNames {"name", "max_reg_hours", "ot_multiplier", "fica_rate", "ss_med_rate"};
+    const auto startTime = chrono::steady_clock::now();
+
+    const bool isOpened = streamCsvFile(path, [&](const size_t lineNumber, const vector<string_view> &fields, const bool isWellFormed) {
+        if (lineNumber == 1 && isCsvHeader(fields, columnNames)) return;
+
+        // Every rule starts as the current one, so an empty field just keeps it
+        PayrollScenario scenario;
+        copy(begin(PAYROLL_RULES), end(PAYROLL_RULES), scenario.rulesByPolicy);
+        double maxRegHours = PAYROLL_RULES[STANDARD_PAYROLL_POLICY].maxRegHours, otMultiplier = PAYROLL_RULES[STANDARD_PAYROLL_POLICY].otMultiplier;
+        double ficaRate = PAYROLL_RULES[STANDARD_PAYROLL_POLICY].ficaRate, ssMedRate = PAYROLL_RULES[STANDARD_PAYROLL_POLICY].ssMedRate;
+        if (!isWellFormed || fields.size() != columnNames.size()) return reportCsvRowError(importReport, lineNumber, "expected 5 fields: name,max_reg_hours,ot_multiplier,fica_rate,ss_med_rate");
+        if (fields[0].empty()) return reportCsvRowError(importReport, lineNumber, "the name can not be empty");
+        if (!fields[1].empty() && !parseCsvDouble(fields[1], maxRegHours)) return reportCsvRowError(importReport, lineNumber, "the maximum regular hours are not a number");
+        if (maxRegHours < 0 || MAX_HOURS_WORKED < maxRegHours) return reportCsvRowError(importReport, lineNumber, "the maximum regular hours must be between 0 & " + to_string(MAX_HOURS_WORKED));
+        if (!fields[2].empty() && !parseCsvDouble(fields[2], otMultiplier)) return reportCsvRowError(importReport, lineNumber, "the overtime multiplier is not a number");
+        if (otMultiplier < 1 || MAX_SIMULATED_OT_MULT < otMultiplier) return reportCsvRowError(importReport, lineNumber, "the overtime multiplier must be between 1 & " + to_string(MAX_SIMULATED_OT_MULT));
+        if (!fields[3].empty() && !parseCsvDouble(fields[3], ficaRate)) return reportCsvRowError(importReport, lineNumber, "the FICA rate is not a number");
+        if (ficaRate < 0 || 1 < ficaRate) return reportCsvRowError(importReport, lineNumber, "the FICA rate must be between 0 & 1");
+        if (!fields[4].empty() && !parseCsvDouble(fields[4], ssMedRate)) return reportCsvRowError(importReport, lineNumber, "the social security rate is not a number");
+        if (ssMedRate < 0 || 1 < ssMedRate) return reportCsvRowError(importReport, lineNumber, "the social security rate must be between 0 & 1");
+
+        // The deductions apply to every payroll policy, but the overtime rules only to the standard one (the overtime-exempt employees still get no overtime)
+        assignCsvField(scenario.name, fields[0]);
+        scenario.rulesByPolicy[STANDARD_PAYROLL_POLICY].maxRegHours = maxRegHours;
+        scenario.rulesByPolicy[STANDARD_PAYROLL_POLICY].otMultiplier = otMultiplier;
+        for (PayrollRules &rules: scenario.rulesByPolicy) {
+            rules.ficaRate = ficaRate;
+            rules.ssMedRate = ssMedRate;
+        }
+        scenarios.push_back(move(scenario));
+        importReport.importedRows++;
+    });
+
+    if (!isOpened) cerr << "The CSV file " << path << " could not be opened." << endl;
+    importReport.rejectedRows += !isOpened;
+    importReport.seconds = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+    return importReport;
+}
+
+// Simulates the company's PayrollReport under the what-if scenarios of a given CSV file, over all the payments of a given PaymentLedger (with the workers of a given ThreadPool),
+// & prints a comparison table per scenario. Returns the program's exit status
+int simulateAndPrintPayrollScenarios(const string &path, const PaymentLedger &paymentLedger, ThreadPool &reportThreadPool) {
+    // The current rules go first, so every scenario gets compared against the very same simulation (rather than the running report, added up in another order)
+    vector<PayrollScenario> scenarios(1);
+    scenarios.front().name = "current";
+    copy(begin(PAYROLL_RULES), end(PAYROLL_RULES), scenarios.front().rulesByPolicy);
+    const CsvImportReport importReport = readPayrollScenariosCsv(path, scenarios);
+    printCsvImportReport(importReport, "scenario");
+    if (importReport.importedRows == 0) {
+        cerr << "There are no what-if scenarios to simulate." << endl;
+        return 1;
+    }
+    if (paymentLedger.size() == 0) {
+        cerr << "There are no payments to simulate the scenarios with." << endl;
+        return 1;
+    }
+
+    const auto startTime = chrono::steady_clock::now();
+    const vector<PayrollReport> simulatedReports = simulatePayrollScenarios(paymentLedger.columns, scenarios, reportThreadPool);
+    const double seconds = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+#ifdef PAYROLL_VERIFY_AGGREGATES
+    verifyPayrollSimulation(paymentLedger, scenarios, simulatedReports);
+#endif
+
+    const double simulatedScenarios = static_cast<double>(importReport.importedRows);
+    const double paymentScenariosPerSecond = seconds > 0 ? simulatedScenarios * static_cast<double>(paymentLedger.size()) / seconds : 0;
+    cout << "Simulated " << humanizeUnsignedInteger(importReport.importedRows) << " scenario" << (importReport.importedRows == 1 ? "" : "s") << " over "
+         << humanizeUnsignedInteger(paymentLedger.size()) << " payment" << (paymentLedger.size() == 1 ? "" : "s") << " in " << fixed << setprecision(3) << seconds
+         << " s (" << humanizeUnsignedInteger(static_cast<unsigned long long>(paymentScenariosPerSecond)) << " payment-scenarios/s)." << endl;
+
+    cout << setprecision(2); // Before the renderer, which follows the stream's format
+    TableRenderer tableRenderer(cout);
+    for (size_t scenario = 1; scenario < scenarios.size(); scenario++) printPayrollScenarioComparisonTable(tableRenderer, scenarios[scenario], simulatedReports.front(), simulatedReports[scenario]);
+    return importReport.rejectedRows == 0 ? 0 : 1;
+}
+
+// Folds a given WriteAheadLog into the ledger file once it has reached the amount of records given by some ProgramOptions (or half the records
+// of the snapshot itself, if that's more: rewriting a big snapshot for just a few changes would cost more than replaying them ever will)
+void compactWriteAheadLogIfNeeded(const ProgramOptions &programOptions, WriteAheadLog &writeAheadLog, const EmployeeRegistry &employeeRegistry, const PaymentLedger &paymentLedger) {
+    const size_t snapshotRecords = employeeRegistry.size() + paymentLedger.size();
+    if (programOptions.logCompactionRecords == 0 || writeAheadLog.recordsAmount < max(programOptions.logCompactionRecords, snapshotRecords / 2)) return;
+    if (!compactWriteAheadLog(programOptions.ledgerFilePath, writeAheadLog, employeeRegistry, paymentLedger)) {
+        cerr << "The ledger file " << programOptions.ledgerFilePath << " could not be saved, so the write-ahead log keeps growing." << endl;
+    }
+}
+
+// Runs the commands read from a given input stream, one per line & with no menu at all, writing a JSON line with the result of each one (& a final summary) to a given output stream.
+// Returns the program's exit status: 0 only if every command succeeded
+int runHeadlessCommands(istream &input, ostream &output, const ProgramOptions &programOptions, EmployeeRegistry &employeeRegistry, PaymentLedger &paymentLedger,
+                        ThreadPool &reportThreadPool, WriteAheadLog &writeAheadLog) {
+    // There is no interleaving with C style I/O here, so the streams don't need to stay synchronized with it (much faster line by line)
+    ios::sync_with_stdio(false);
+    input.tie(nullptr);
+
+    string line;
+    string results; // Gathered & written out by blocks, instead of line by line
+    vector<string_view> words;
+    size_t lineNumber = 0;
+    size_t commandsAmount = 0;
+    size_t failedCommandsAmount = 0;
+    const auto startTime = chrono::steady_clock::now();
+
+    while (getline(input, line)) {
+        lineNumber++;
+        if (!line.empty() && line.back() == '\r') line.pop_back(); // Windows line breaks
+        const bool isWellFormed = splitCommandLine(line, words);
+        if (words.empty() || words.front().front() == '#') continue; // Blank lines & comments
+
+        commandsAmount++;
+        results += "{\"line\":";
+        results += to_string(lineNumber);
+        results += ",\"command\":";
+        appendJsonString(results, words.front());
+
+        // Every result says if the command succeeded, plus either its outcome or why it failed
+        const size_t resultStart = results.size();
+        const bool isSuccessful = isWellFormed && runHeadlessCommand(words, results, employeeRegistry, paymentLedger, reportThreadPool, writeAheadLog);
+        if (!isWellFormed) results += ",\"ok\":false,\"error\":\"unbalanced quotes\"";
+        failedCommandsAmount += !isSuccessful;
+        results.insert(resultStart, isSuccessful ? ",\"ok\":true" : "");
+        results += "}\n";
+
+        compactWriteAheadLogIfNeeded(programOptions, writeAheadLog, employeeRegistry, paymentLedger);
+        if (results.size() >= HEADLESS_OUTPUT_BLOCK_SIZE) {
+            output.write(results.data(), static_cast<streamsize>(results.size()));
+            results.clear();
+        }
+    }
+
+    // & finally the throughput of the whole run
+    const double seconds = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+    results += "{\"summary\":{\"commands\":";
+    results += to_string(commandsAmount);
+    results += ",\"failed\":";
+    results += to_string(failedCommandsAmount);
+    results += ",\"seconds\":";
+    appendJsonNumber(results, seconds);
+    results += ",\"opsPerSecond\":";
+    appendJsonNumber(results, seconds > 0 ? round(commandsAmount / seconds) : 0);
+    results += "}}\n";
+    output.write(results.data(), static_cast<streamsize>(results.size()));
+    output.flush();
+
+    return failedCommandsAmount == 0 ? 0 : 1;
+}
+
+// Runs a single headless command, given its (already split) words, appending the rest of its JSON result to the reference of a given string. Returns false if it failed
+bool runHeadlessCommand(const vector<string_view> &words, string &result, EmployeeRegistry &employeeRegistry, PaymentLedger &paymentLedger,
+                        ThreadPool &reportThreadPool, WriteAheadLog &writeAheadLog) {
+    PAYROLL_TIME_OPERATION(RUN_HEADLESS_COMMAND_OPERATION);
+    const string_view command = words.front();
+    const size_t argumentsAmount = words.size() - 1;
+
+    // Appends the reason why the command failed
+    const auto fail = [&](const string_view error) {
+        result += ",\"ok\":false,\"error\":";
+        appendJsonString(result, error);
+        return false;
+    };
+
+    // Retrieves the current employee whose id is a given word (or nullptr, if there is none)
+    const auto findEmployee = [&](const string_view employeeIdText) -> const Employee * {
+        EmployeeId employeeId;
+        if (!parseEmployeeId(employeeIdText, employeeId)) return nullptr;
+        const auto indexIterator = employeeRegistry.positionsById.find(employeeId);
+        return indexIterator == employeeRegistry.positionsById.end() ? nullptr : &employeeRegistry.employees[indexIterator->second];
+    };
+
+    // The very same validations (& the very same logging) as the menu options
+    if (command == "add-employee") {
+        double regRate;
+        PayrollPolicy payrollPolicy = STANDARD_PAYROLL_POLICY;
+        if (argumentsAmount != 3 && argumentsAmount != 4) return fail("usage: add-employee FIRST_NAME LAST_NAME REG_RATE [PAYROLL_POLICY]");
+        if (words[1].empty() || words[2].empty()) return fail("the first & last names can not be empty");
+        if (!parseCsvDouble(words[3], regRate) || regRate < MIN_HOURLY_WAGE || MAX_HOURLY_WAGE < regRate) {
+            return fail("the regular rate must be a number between " + monetizeDouble(MIN_HOURLY_WAGE) + " & " + monetizeDouble(MAX_HOURLY_WAGE));
+        }
+        if (argumentsAmount == 4 && !parsePayrollPolicy(words[4], payrollPolicy)) {
+            return fail("the payroll policy must be " + string(PAYROLL_RULES[STANDARD_PAYROLL_POLICY].name) + " or " + string(PAYROLL_RULES[OVERTIME_EXEMPT_PAYROLL_POLICY].name));
+        }
+
+        Employee employee {.id = generateEmployeeId(), .firstName = string(words[1]), .lastName = string(words[2]), .regRate = regRate, .payrollPolicy = payrollPolicy};
+        result += ",\"id\":";
+        appendJsonEmployeeId(result, employee.id);
+        logEmployeeAddition(writeAheadLog, employee);
+        insertEmployee(employeeRegistry, move(employee));
+        return true;
+    }
+
+    if (command == "delete-employee") {
+        if (argumentsAmount != 1) return fail("usage: delete-employee EMPLOYEE_ID");
+        const Employee *employee = findEmployee(words[1]);
+        if (employee == nullptr) return fail("there is no current employee with such id");
+
+        const EmployeeId employeeId = employee->id; // A copy, as the employee is about to be gone
+        logEmployeeDeletion(writeAheadLog, employeeId);
+        deleteEmployeById(employeeRegistry, employeeId);
+        return true;
+    }
+
+    // Appends the report of the company's payments within a given range of pay dates (both included)
+    const auto appendPayDatesReport = [&](const int32_t firstPayDate, const int32_t lastPayDate) {
+        const PayrollReport additionPayrollReport = createAdditionPayrollReportOfPayDates(paymentLedger, firstPayDate, lastPayDate);
+        result += ",\"firstPayDate\":\"";
+        result += isoDateToString(firstPayDate);
+        result += "\",\"lastPayDate\":\"";
+        result += isoDateToString(lastPayDate);
+        result += "\",\"payments\":";
+        result += to_string(additionPayrollReport.paymentsAmount);
+        result += ",\"addition\":";
+        appendJsonPayrollReport(result, additionPayrollReport);
+        result += ",\"average\":";
+        if (additionPayrollReport.paymentsAmount == 0) result += "null"; // There is nothing to average
+        else appendJsonPayrollReport(result, createAveragePayrollReportFromAddition(additionPayrollReport));
+        return true;
+    };
+
+    // Reads a given word as a whole integer number between some given limits (both included)
+    const auto parseInteger = [](const string_view word, const int minValue, const int maxValue, int &value) {
+        const auto [pointer, errorCode] = from_chars(word.data(), word.data() + word.size(), value);
+        return errorCode == errc() && pointer == word.data() + word.size() && minValue <= value && value <= maxValue;
+    };
+
+    if (command == "add-payment") {
+        double hoursWorked;
+        int32_t payDate = getTodaysDate();
+        if (argumentsAmount != 2 && argumentsAmount != 3) return fail("usage: add-payment EMPLOYEE_ID HOURS_WORKED [PAY_DATE]");
+        const Employee *employee = findEmployee(words[1]);
+        if (employee == nullptr) return fail("there is no current employee with such id");
+        if (!parseCsvDouble(words[2], hoursWorked) || hoursWorked < 1 || MAX_HOURS_WORKED < hoursWorked) {
+            return fail("the hours worked must be a number between 1 & " + to_string(MAX_HOURS_WORKED));
+        }
+        if (argumentsAmount == 3 && !parseIsoDate(words[3], payDate)) return fail("the pay date must be a valid date (YYYY-MM-DD)");
+
+        const Payment payment {.employeeId = employee->id, .firstName = employee->firstName, .lastName = employee->lastName, .hoursWorked = hoursWorked, .regRate = employee->regRate,
+                               .payDate = payDate, .payrollPolicy = employee->payrollPolicy};
+        logPaymentAddition(writeAheadLog, payment);
+        insertPayment(paymentLedger, payment);
+        return true;
+    }
+
+    if (command == "report-company") {
+        if (argumentsAmount != 0) return fail("usage: report-company");
+        if (paymentLedger.empty()) return fail("the company has not made any payment yet");
+
+        const PayrollReport &additionPayrollReport = paymentLedger.companyAdditionPayrollReport;
+        result += ",\"payments\":";
+        result += to_string(additionPayrollReport.paymentsAmount);
+        result += ",\"addition\":";
+        appendJsonPayrollReport(result, additionPayrollReport);
+        result += ",\"average\":";
+        appendJsonPayrollReport(result, createAveragePayrollReportFromAddition(additionPayrollReport));
+        return true;
+    }
+
+    if (command == "report-pay-dates") {
+        int32_t firstPayDate, lastPayDate;
+        if (argumentsAmount != 2) return fail("usage: report-pay-dates FIRST_PAY_DATE LAST_PAY_DATE");
+        if (!parseIsoDate(words[1], firstPayDate) || !parseIsoDate(words[2], lastPayDate)) return fail("the pay dates must be valid dates (YYYY-MM-DD)");
+        if (lastPayDate < firstPayDate) return fail("the last pay date can not be before the first one");
+        return appendPayDatesReport(firstPayDate, lastPayDate);
+    }
+
+    if (command == "report-quarter") {
+        int year, quarter;
+        int32_t firstPayDate, lastPayDate;
+        if (argumentsAmount != 2) return fail("usage: report-quarter YEAR QUARTER");
+        if (!parseInteger(words[1], 1, 9999, year) || !parseInteger(words[2], 1, 4, quarter)) return fail("the year must be between 1 & 9999, & the quarter between 1 & 4");
+        getQuarterDates(year, quarter, firstPayDate, lastPayDate);
+        return appendPayDatesReport(firstPayDate, lastPayDate);
+    }
+
+    if (command == "report-year-to-date") {
+        int32_t lastPayDate = getTodaysDate();
+        if (argumentsAmount > 1) return fail("usage: report-year-to-date [DATE]");
+        if (argumentsAmount == 1 && !parseIsoDate(words[1], lastPayDate)) return fail("the date must be a valid date (YYYY-MM-DD)");
+        return appendPayDatesReport(getFirstDateOfYear(lastPayDate), lastPayDate);
+    }
+
+    if (command == "report-employee") {
+        if (argumentsAmount != 1) return fail("usage: report-employee EMPLOYEE_ID");
+        const Employee *employee = findEmployee(words[1]);
+        if (employee == nullptr) return fail("there is no current employee with such id");
+        if (!employeeHasPayments(paymentLedger, employee->id)) return fail("the employee has not received any payment yet");
+
+        const PayrollReportSummary<EmployeePayrollReport> summary = createCurrentEmployeePayrollReportSummary(paymentLedger, *employee, reportThreadPool);
+        result += ",\"employeeId\":";
+        appendJsonEmployeeId(result, employee->id);
+        result += ",\"firstName\":";
+        appendJsonString(result, employee->firstName);
+        result += ",\"lastName\":";
+        appendJsonString(result, employee->lastName);
+        result += ",\"payments\":";
+        result += to_string(summary.addition.paymentsAmount);
+        result += ",\"addition\":";
+        appendJsonPayrollReport(result, summary.addition);
+        result += ",\"average\":";
+        appendJsonPayrollReport(result, summary.average);
+        return true;
+    }
+
+    return fail("unknown command");
+}
+
+// Splits a given command line into the reference of a given vector of words (separated by blanks, or surrounded by double quotes). Returns false if its quotes are not balanced
+bool splitCommandLine(const string_view line, vector<string_view> &words) {
+    words.clear();
+    size_t position = 0;
+    while (true) {
+        position = line.find_first_not_of(" \t", position);
+        if (position == string_view::npos) return true;
+
+        if (line[position] == '"') {
+            const size_t closingQuote = line.find('"', position + 1);
+            if (closingQuote == string_view::npos) return false;
+            words.push_back(line.substr(position + 1, closingQuote - position - 1));
+            position = closingQuote + 1;
+        } else {
+            const size_t wordEnd = min(line.find_first_of(" \t", position), line.size());
+            words.push_back(line.substr(position, wordEnd - position));
+            position = wordEnd;
+        }
+    }
+}
+
+// Appends a given string to the reference of a given JSON text, as a JSON string (quoted & escaped)
+void appendJsonString(string &json, const string_view aString) {
+    json += '"';
+    for (const char character: aString) {
+        switch (character) {
+            case '"': json += "\\\""; break;
+            case '\\': json += "\\\\"; break;
+            case '\n': json += "\\n"; break;
+            case '\t': json += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(character) < 0x20) {
+                    constexpr char hexDigits[] = "0123456789abcdef";
+                    json += "\\u00";
+                    json += hexDigits[character >> 4];
+                    json += hexDigits[character & 0xF];
+                } else {
+                    json += character;
+                }
+        }
+    }
+    json += '"';
+}
+
+// Appends a given number to the reference of a given JSON text, as the shortest JSON number that reads back exactly as it
+void appendJsonNumber(string &json, const double number) {
+    if (!isfinite(number)) {
+        json += "null"; // JSON has no infinities nor NaNs
+        return;
+    }
+    char digits[32]; // Always enough for the shortest form of any double
+    const char *const end = to_chars(digits, digits + sizeof(digits), number).ptr;
+    json.append(digits, end - digits);
+}
+
+// Appends a given employee's id to the reference of a given JSON text, as a JSON string (its characters never need to be escaped)
+void appendJsonEmployeeId(string &json, const EmployeeId &employeeId) {
+    char employeeIdText[EMPLOYEE_ID_TEXT_LENGTH];
+    json += '"';
+    json.append(employeeIdText, formatEmployeeId(employeeIdText, employeeId) - employeeIdText);
+    json += '"';
+}
+
+// Appends a given PayrollReport to the reference of a given JSON text, as a JSON object with all its fields (the derived ones too)
+void appendJsonPayrollReport(string &json, const PayrollReport &payrollReport) {
+    const pair<const char *, double> fields[] = {
+        {"regHours", payrollReport.regHours}, {"otHours", payrollReport.otHours}, {"regPay", payrollReport.regPay.dollars()}, {"otPay", payrollReport.otPay.dollars()},
+        {"fica", payrollReport.fica.dollars()}, {"socSec", payrollReport.socSec.dollars()}, {"totalPay", payrollReport.totalPay().dollars()},
+        {"totalDeductions", payrollReport.totDeductions().dollars()}, {"netPay", payrollReport.netPay().dollars()}
+    };
+
+    json += '{';
+    for (const auto &[name, value]: fields) {
+        if (json.back() != '{') json += ',';
+        json += '"';
+        json += name;
+        json += "\":";
+        appendJsonNumber(json, value);
+    }
+    json += '}';
+}
+
+// Generates in parallel a EmployeePayrollReport with the addition of all the payments related to a given employee, merging the chunks' partial reports deterministically
+EmployeePayrollReport createAdditionEmployeePayrollReportInParallel(const PaymentLedger &paymentLedger, const Employee &employee, ThreadPool &threadPool) {
+    PAYROLL_TIME_OPERATION(CREATE_ADDITION_EPR_IN_PARALLEL_OPERATION);
+    EmployeePayrollReport theAdditionEmployeePayrollReport = createEmptyEmployeePayrollReport(paymentLedger, employee); // Gets associated to the employee
+
+    // An employee without payments has no entry in the index, so the report just stays empty
+    const auto indexIterator = paymentLedger.paymentPositionsByEmployeeId.find(employee.id);
+    if (indexIterator == paymentLedger.paymentPositionsByEmployeeId.end()) return theAdditionEmployeePayrollReport;
+
+    const vector<size_t> &paymentPositions = indexIterator->second;
+    const size_t chunksAmount = (paymentPositions.size() + PARALLEL_REPORT_CHUNK_SIZE - 1) / PARALLEL_REPORT_CHUNK_SIZE;
+    const PaymentColumns &columns = paymentLedger.columns;
+
+    // The employee's payments are scattered along the columns, so each chunk gathers its own ones first, & then runs the aggregation kernel over them
+    static_cast<PayrollReport &>(theAdditionEmployeePayrollReport) = aggregateChunksInParallel(chunksAmount, [&](const size_t chunk) {
+        const size_t firstPosition = chunk * PARALLEL_REPORT_CHUNK_SIZE;
+        const size_t lastPosition = min(firstPosition + PARALLEL_REPORT_CHUNK_SIZE, paymentPositions.size());
+        vector<double> hoursWorked, regRates;
+        vector<PayrollPolicy> payrollPolicies;
+        hoursWorked.reserve(lastPosition - firstPosition);
+        regRates.reserve(lastPosition - firstPosition);
+        payrollPolicies.reserve(lastPosition - firstPosition);
+        bool hasMixedPayrollPolicies = false;
+        for (size_t i = firstPosition; i < lastPosition; i++) {
+            hoursWorked.push_back(columns.hoursWorked[paymentPositions[i]]);
+            regRates.push_back(columns.regRates[paymentPositions[i]]);
+            payrollPolicies.push_back(columns.payrollPolicies[paymentPositions[i]]);
+            hasMixedPayrollPolicies |= payrollPolicies.back() != payrollPolicies.front();
+        }
+        return aggregatePaymentColumns(hoursWorked.data(), regRates.data(), payrollPolicies.data(), hoursWorked.size(), hasMixedPayrollPolicies);
+    }, threadPool);
+
+    return theAdditionEmployeePayrollReport;
+}
+
+// Adds up a given amount of chunks, running the given chunk's aggregation as the tasks of a given ThreadPool, & merging their partial reports as a tree
+PayrollReport aggregateChunksInParallel(const size_t chunksAmount, const function<PayrollReport(size_t)> &aggregateChunk, ThreadPool &threadPool) {
+    vector<PayrollReport> partialReports(chunksAmount); // Each task writes only its own one, so they need no locking
+    threadPool.runTasks(chunksAmount, [&](const size_t chunk) { partialReports[chunk] = aggregateChunk(chunk); });
+    return reducePayrollReportsAsTree(move(partialReports));
+}
+
+// Merges two given addition PayrollReports into a single one, as if all their payments had been added into the same report
+PayrollReport mergePayrollReports(const PayrollReport &a, const PayrollReport &b) {
+    return PayrollReport {.paymentsAmount = a.paymentsAmount + b.paymentsAmount, .regHours = a.regHours + b.regHours, .otHours = a.otHours + b.otHours,
+                          .regPay = a.regPay + b.regPay, .otPay = a.otPay + b.otPay, .fica = a.fica + b.fica, .socSec = a.socSec + b.socSec};
+}
+
+// Reduces a given vector of partial PayrollReports into a single one, always merging neighbours pairwise (a balanced tree), so the result depends only on the partial reports
+PayrollReport reducePayrollReportsAsTree(vector<PayrollReport> reports) {
+    if (reports.empty()) return PayrollReport {};
+
+    // Each level merges the reports 0 & 1, 2 & 3, & so on (an odd last one just goes up a level as it is), until only one remains
+    while (reports.size() > 1) {
+        const size_t mergedAmount = (reports.size() + 1) / 2;
+        for (size_t i = 0; i < mergedAmount; i++) {
+            reports[i] = 2 * i + 1 < reports.size() ? mergePayrollReports(reports[2 * i], reports[2 * i + 1]) : reports[2 * i];
+        }
+        reports.resize(mergedAmount);
+    }
+
+    return reports.front();
+}
+
+// Simulates the addition PayrollReport of all the payments of some given PaymentColumns under each one of some given what-if scenarios. The scenarios get vectorized (one per lane),
+// & the chunks of payments get spread among the workers of a given ThreadPool, merged as a tree (so the results never depend on the amount of workers)
+vector<PayrollReport> simulatePayrollScenarios(const PaymentColumns &columns, const vector<PayrollScenario> &scenarios, ThreadPool &threadPool) {
+    PAYROLL_TIME_OPERATION(SIMULATE_SCENARIOS_OPERATION);
+    PAYROLL_COUNT(PAYMENT_SCENARIOS_SIMULATED_COUNTER, columns.hoursWorked.size() * scenarios.size());
+    const size_t chunksAmount = columns.hoursWorked.chunksAmount();
+    const size_t scenarioGroupsAmount = (scenarios.size() + SIMULATION_SCENARIOS_PER_TASK - 1) / SIMULATION_SCENARIOS_PER_TASK;
+
+    // Each task simulates a group of scenarios over one chunk of the columns, writing only its own partial reports (so they need no locking)
+    vector<vector<PayrollReport>> partialReportsByChunk(chunksAmount, vector<PayrollReport>(scenarios.size()));
+    threadPool.runTasks(chunksAmount * scenarioGroupsAmount, [&](const size_t task) {
+        const size_t chunk = task / scenarioGroupsAmount;
+        const size_t firstScenario = task % scenarioGroupsAmount * SIMULATION_SCENARIOS_PER_TASK;
+        const size_t scenariosAmount = min(SIMULATION_SCENARIOS_PER_TASK, scenarios.size() - firstScenario);
+        simulatePaymentColumns(columns.hoursWorked.chunkData(chunk), columns.regRates.chunkData(chunk), columns.payrollPolicies.chunkData(chunk), columns.hoursWorked.chunkSize(chunk),
+                               scenarios.data() + firstScenario, scenariosAmount, partialReportsByChunk[chunk].data() + firstScenario);
+    });
+
+    // The partial reports of each scenario get merged just like the ones of any other parallel report
+    vector<PayrollReport> reports(scenarios.size());
+    vector<PayrollReport> scenarioPartialReports(chunksAmount);
+    for (size_t scenario = 0; scenario < scenarios.size(); scenario++) {
+        for (size_t chunk = 0; chunk < chunksAmount; chunk++) scenarioPartialReports[chunk] = partialReportsByChunk[chunk][scenario];
+        reports[scenario] = reducePayrollReportsAsTree(scenarioPartialReports);
+    }
+    return reports;
+}
+
+// What-if simulation kernel: adds the payments of some given contiguous columns (hours worked, regular rates & payroll policies) into the given reports
+// of some given scenarios (one report per scenario), through the AVX2 kernel when the CPU supports it
+void simulatePaymentColumns(const double *hoursWorked, const double *regRates, const PayrollPolicy *payrollPolicies, const size_t paymentsAmount,
+                            const PayrollScenario *scenarios, const size_t scenariosAmount, PayrollReport *reports) {
+#ifdef PAYROLL_HAS_AVX2_KERNELS
+    static const bool cpuSupportsAvx2 = __builtin_cpu_supports("avx2"); // Only checked once
+    if (cpuSupportsAvx2) return simulatePaymentColumnsAvx2(hoursWorked, regRates, payrollPolicies, paymentsAmount, scenarios, scenariosAmount, reports);
+#endif
+    simulatePaymentColumnsScalar(hoursWorked, regRates, payrollPolicies, paymentsAmount, scenarios, scenariosAmount, reports);
+}
+
+// Portable what-if simulation kernel: every scenario adds the payments one by one, with the very same operations (& therefore the very same results) as the AVX2 kernel
+void simulatePaymentColumnsScalar(const double *hoursWorked, const double *regRates, const PayrollPolicy *payrollPolicies, const size_t paymentsAmount,
+                                  const PayrollScenario *scenarios, const size_t scenariosAmount, PayrollReport *reports) {
+    // A tile of payments at a time, so every scenario finds them in the cache
+    for (size_t firstPayment = 0; firstPayment < paymentsAmount; firstPayment += SIMULATION_TILE_SIZE) {
+        const size_t tileEnd = min(paymentsAmount, firstPayment + SIMULATION_TILE_SIZE);
+        for (size_t scenario = 0; scenario < scenariosAmount; scenario++) {
+            const PayrollRules (&rulesByPolicy)[PAYROLL_POLICIES_AMOUNT] = scenarios[scenario].rulesByPolicy;
+            for (size_t i = firstPayment; i < tileEnd; i++) {
+                addPaymentFiguresToPayrollReport(reports[scenario], computePaymentFigures(hoursWorked[i], regRates[i], rulesByPolicy[payrollPolicies[i]]));
+            }
+        }
+    }
+}
+
+#ifdef PAYROLL_HAS_AVX2_KERNELS
+// AVX2 what-if simulation kernel: 4 scenarios at a time (one per lane) go through each payment, each one adding the payments in their order
+__attribute__((target("avx2"))) void simulatePaymentColumnsAvx2(const double *hoursWorked, const double *regRates, const PayrollPolicy *payrollPolicies, const size_t paymentsAmount,
+                                                                const PayrollScenario *scenarios, const size_t scenariosAmount, PayrollReport *reports) {
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d centsPerDollar = _mm256_set1_pd(100.0);
+
+    // A tile of payments at a time, so every group of scenarios finds them in the cache
+    for (size_t firstPayment = 0; firstPayment < paymentsAmount; firstPayment += SIMULATION_TILE_SIZE) {
+        const size_t tileEnd = min(paymentsAmount, firstPayment + SIMULATION_TILE_SIZE);
+        for (size_t firstScenario = 0; firstScenario < scenariosAmount; firstScenario += KERNEL_LANES) {
+            const size_t lanesAmount = min(static_cast<size_t>(KERNEL_LANES), scenariosAmount - firstScenario); // The unused lanes repeat the last scenario, & get discarded
+
+            // The rules of each payroll policy, with one scenario per lane
+            __m256d maxRegHours[PAYROLL_POLICIES_AMOUNT], otMultiplier[PAYROLL_POLICIES_AMOUNT], ficaRate[PAYROLL_POLICIES_AMOUNT], ssMedRate[PAYROLL_POLICIES_AMOUNT];
+            for (int policy = 0; policy < PAYROLL_POLICIES_AMOUNT; policy++) {
+                double rules[4][KERNEL_LANES];
+                for (size_t lane = 0; lane < KERNEL_LANES; lane++) {
+                    const PayrollRules &laneRules = scenarios[firstScenario + min(lane, lanesAmount - 1)].rulesByPolicy[policy];
+                    rules[0][lane] = laneRules.maxRegHours;
+                    rules[1][lane] = laneRules.otMultiplier;
+                    rules[2][lane] = laneRules.ficaRate;
+                    rules[3][lane] = laneRules.ssMedRate;
+                }
+                maxRegHours[policy] = _mm256_loadu_pd(rules[0]);
+                otMultiplier[policy] = _mm256_loadu_pd(rules[1]);
+                ficaRate[policy] = _mm256_loadu_pd(rules[2]);
+                ssMedRate[policy] = _mm256_loadu_pd(rules[3]);
+            }
+
+            // The additions so far of each scenario, one per lane
+            KernelLanes sums;
+            for (size_t lane = 0; lane < lanesAmount; lane++) {
+                const PayrollReport &report = reports[firstScenario + lane];
+                sums.hours[0][lane] = report.regHours;
+                sums.hours[1][lane] = report.otHours;
+                sums.cents[0][lane] = report.regPay.cents;
+                sums.cents[1][lane] = report.otPay.cents;
+                sums.cents[2][lane] = report.fica.cents;
+                sums.cents[3][lane] = report.socSec.cents;
+            }
+            __m256d regHoursSum = _mm256_loadu_pd(sums.hours[0]), otHoursSum = _mm256_loadu_pd(sums.hours[1]);
+            __m256i regPaySum = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(sums.cents[0])), otPaySum = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(sums.cents[1]));
+            __m256i ficaSum = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(sums.cents[2])), socSecSum = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(sums.cents[3]));
+
+            for (size_t i = firstPayment; i < tileEnd; i++) {
+                const __m256d hours = _mm256_set1_pd(hoursWorked[i]);
+                const __m256d rate = _mm256_set1_pd(regRates[i]);
+                const PayrollPolicy policy = payrollPolicies[i];
+
+                // Same operations as the Payment's member functions (the blends play the role of their ternary operators), with no fused multiply-adds.
+                // The money gets rounded to whole cents just like Money does it, & only then gets added up, as integers
+                const __m256d isRegularOnly = _mm256_cmp_pd(hours, maxRegHours[policy], _CMP_LE_OQ);
+                const __m256d regHours = _mm256_blendv_pd(maxRegHours[policy], hours, isRegularOnly);
+                const __m256d otHours = _mm256_blendv_pd(_mm256_sub_pd(hours, maxRegHours[policy]), zero, isRegularOnly);
+                __m256d regPay, otPay;
+                const __m256i regPayCents = roundCentsAvx2(_mm256_mul_pd(_mm256_mul_pd(regHours, rate), centsPerDollar), regPay);
+                const __m256i otPayCents = roundCentsAvx2(_mm256_mul_pd(_mm256_mul_pd(otHours, _mm256_mul_pd(rate, otMultiplier[policy])), centsPerDollar), otPay);
+                const __m256d totalPay = _mm256_add_pd(regPay, otPay); // Exact, as both are whole cents
+
+                regHoursSum = _mm256_add_pd(regHoursSum, regHours);
+                otHoursSum = _mm256_add_pd(otHoursSum, otHours);
+                regPaySum = _mm256_add_epi64(regPaySum, regPayCents);
+                otPaySum = _mm256_add_epi64(otPaySum, otPayCents);
+                ficaSum = _mm256_add_epi64(ficaSum, roundCentsAvx2(_mm256_mul_pd(totalPay, ficaRate[policy])));
+                socSecSum = _mm256_add_epi64(socSecSum, roundCentsAvx2(_mm256_mul_pd(totalPay, ssMedRate[policy])));
+            }
+
+            _mm256_storeu_pd(sums.hours[0], regHoursSum);
+            _mm256_storeu_pd(sums.hours[1], otHoursSum);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(sums.cents[0]), regPaySum);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(sums.cents[1]), otPaySum);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(sums.cents[2]), ficaSum);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(sums.cents[3]), socSecSum);
+            for (size_t lane = 0; lane < lanesAmount; lane++) {
+                PayrollReport &report = reports[firstScenario + lane];
+                report.paymentsAmount += static_cast<int>(tileEnd - firstPayment);
+                report.regHours = sums.hours[0][lane];
+                report.otHours = sums.hours[1][lane];
+                report.regPay.cents = sums.cents[0][lane];
+                report.otPay.cents = sums.cents[1][lane];
+                report.fica.cents = sums.cents[2][lane];
+                report.socSec.cents = sums.cents[3][lane];
+            }
+        }
+    }
+}
+#endif
+
+// Starts the given amount of workers (minus one, as the thread that runs a job also takes part on it)
+ThreadPool::ThreadPool(const unsigned workersAmount) {
+    for (unsigned i = 1; i < workersAmount; i++) {
+        threads.emplace_back([this]() { workerLoop(); });
+    }
+}
+
+// Stops & waits for all the started threads
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> lock(jobMutex);
+        stopping = true;
+    }
+    jobStarted.notify_all();
+    for (thread &aThread: threads) aThread.join();
+}
+
+// Runs the given task once for every index from 0 to the given amount (excluded), & returns only when all of them have finished
+void ThreadPool::runTasks(const size_t amount, const function<void(size_t)> &task) {
+    if (amount == 0) return;
+
+    {
+        lock_guard<mutex> lock(jobMutex);
+        currentTask = &task;
+        tasksAmount = amount;
+        nextTaskIndex = 0;
+        finishedTasksAmount = 0;
+        jobNumber++;
+    }
+    jobStarted.notify_all();
+
+    const size_t tasksDoneHere = takeTasks(); // The calling thread works too, instead of just waiting
+
+    unique_lock<mutex> lock(jobMutex);
+    finishedTasksAmount += tasksDoneHere;
+    jobFinished.wait(lock, [&]() { return finishedTasksAmount == tasksAmount && busyThreads == 0; });
+    currentTask = nullptr;
+}
+
+// Runs tasks of the current job, until there are no more left. Returns how many it ran
+size_t ThreadPool::takeTasks() {
+    size_t tasksDoneHere = 0;
+    for (size_t taskIndex = nextTaskIndex++; taskIndex < tasksAmount; taskIndex = nextTaskIndex++) {
+        (*currentTask)(taskIndex);
+        tasksDoneHere++;
+    }
+    return tasksDoneHere;
+}
+
+// What each one of the started threads does, until the pool gets destroyed
+void ThreadPool::workerLoop() {
+    unsigned long long lastJobNumber = 0;
+    while (true) {
+        {
+            unique_lock<mutex> lock(jobMutex);
+            jobStarted.wait(lock, [&]() { return stopping || (jobNumber != lastJobNumber && currentTask != nullptr); });
+            if (stopping) return;
+            lastJobNumber = jobNumber;
+            busyThreads++;
+        }
+
+        const size_t tasksDoneHere = takeTasks();
+
+        lock_guard<mutex> lock(jobMutex);
+        finishedTasksAmount += tasksDoneHere;
+        busyThreads--;
+        if (finishedTasksAmount == tasksAmount && busyThreads == 0) jobFinished.notify_all();
+    }
+}
+
+// Checks that the aggregation kernels match bit for bit the Payment's member functions (payment by payment), that the AVX2 ones match the scalar ones lane by lane
+// (over blocks of payments, masked or not), & that all kernels agree with each other. Aborts if not
+void verifyPaymentColumnKernels(const PaymentLedger &paymentLedger) {
+    const PaymentColumns &columns = paymentLedger.columns;
+
+    // Determines if two given PayrollReports are identical, bit for bit (not just equal within some tolerance)
+    const auto areIdentical = [](const PayrollReport &a, const PayrollReport &b) {
+        const double aHours[] = {a.regHours, a.otHours};
+        const double bHours[] = {b.regHours, b.otHours};
+        return a.paymentsAmount == b.paymentsAmount && memcmp(aHours, bHours, sizeof(aHours)) == 0 && a.regPay == b.regPay && a.otPay == b.otPay && a.fica == b.fica &&
+               a.socSec == b.socSec;
+    };
+
+    // Aborts with a given message
+    const auto fail = [](const string &message) {
+        cerr << message << endl;
+        abort();
+    };
+
+    // Runs a given accumulation kernel over the columns (chunk by chunk, when it's more than one payment), getting its PayrollReport. The masked kernels can be forced
+    using AccumulationKernel = void (*)(const double *, const double *, const PayrollPolicy *, size_t, bool, KernelLanes &);
+    const auto runKernel = [&columns](const AccumulationKernel kernel, const size_t firstPayment, const size_t paymentsAmount, const bool hasMixedPayrollPolicies) {
+        KernelLanes lanes;
+        if (paymentsAmount == 1) {
+            kernel(&columns.hoursWorked[firstPayment], &columns.regRates[firstPayment], &columns.payrollPolicies[firstPayment], 1, hasMixedPayrollPolicies, lanes);
+        } else {
+            for (size_t chunk = 0; chunk < columns.hoursWorked.chunksAmount(); chunk++) {
+                kernel(columns.hoursWorked.chunkData(chunk), columns.regRates.chunkData(chunk), columns.payrollPolicies.chunkData(chunk), columns.hoursWorked.chunkSize(chunk),
+                       hasMixedPayrollPolicies, lanes);
+            }
+        }
+        return combineKernelLanes(lanes, paymentsAmount);
+    };
+
+    // A kernel over a single payment leaves it alone in its lane, so its figures must be exactly the ones from the Payment's member functions
+    // (also through the masked kernels, where the passes of the other payroll policies must add nothing but zeros)
+    for (size_t i = 0; i < columns.size(); i++) {
+        const Payment payment = getPayment(paymentLedger, i);
+        const PayrollReport expected {.paymentsAmount = 1, .regHours = payment.regHours(), .otHours = payment.otHours(), .regPay = payment.regPay(),
+                                      .otPay = payment.otPay(), .fica = payment.fica(), .socSec = payment.socSec()};
+        for (const bool isMasked: {false, true}) {
+            if (!areIdentical(runKernel(accumulatePaymentColumnsScalar, i, 1, isMasked), expected)) fail("The scalar aggregation kernels do not match the Payment's member functions.");
+#ifdef PAYROLL_HAS_AVX2_KERNELS
+            if (__builtin_cpu_supports("avx2") && !areIdentical(runKernel(accumulatePaymentColumnsAvx2, i, 1, isMasked), expected))
+                fail("The AVX2 aggregation kernels do not match the Payment's member functions.");
+#endif
+        }
+    }
+
+    // A single payment never reaches the vectorized body of the AVX2 kernels, so they also run over blocks of 4 to 7 payments (their vectorized body & every tail
+    // of 0 to 3 payments), where every lane must match the one of the scalar kernels, bit for bit. The lanes' money must also be exactly the one of the payments
+    // that fell into each lane. Every block runs masked too, with its payments' own payroll policies & then alternating them, so there are always mixed blocks
+    const auto verifyKernelsOverBlock = [&fail](const double *hoursWorked, const double *regRates, const PayrollPolicy *payrollPolicies, const size_t paymentsAmount,
+                                                const bool isMasked) {
+        KernelLanes scalarLanes, expectedLanes;
+        accumulatePaymentColumnsScalar(hoursWorked, regRates, payrollPolicies, paymentsAmount, isMasked, scalarLanes);
+        for (size_t i = 0; i < paymentsAmount; i++) {
+            const Payment payment {.hoursWorked = hoursWorked[i], .regRate = regRates[i], .payrollPolicy = payrollPolicies[i]};
+            const Money amounts[KERNEL_MONEY_FIELDS] = {payment.regPay(), payment.otPay(), payment.fica(), payment.socSec()};
+            for (int field = 0; field < KERNEL_MONEY_FIELDS; field++) expectedLanes.cents[field][i % KERNEL_LANES] += amounts[field].cents;
+        }
+        if (memcmp(scalarLanes.cents, expectedLanes.cents, sizeof(expectedLanes.cents)) != 0) fail("The scalar aggregation kernels do not match the Payment's member functions, lane by lane.");
+#ifdef PAYROLL_HAS_AVX2_KERNELS
+        if (!__builtin_cpu_supports("avx2")) return;
+        KernelLanes avx2Lanes;
+        accumulatePaymentColumnsAvx2(hoursWorked, regRates, payrollPolicies, paymentsAmount, isMasked, avx2Lanes);
+        if (memcmp(&avx2Lanes, &scalarLanes, sizeof(KernelLanes)) != 0) fail("The AVX2 aggregation kernels do not match the scalar ones, lane by lane.");
+#endif
+    };
+    constexpr size_t MAX_BLOCK_SIZE = 2 * KERNEL_LANES - 1;
+    for (size_t firstPayment = 0, block = 0, blockSize; firstPayment < columns.size(); firstPayment += blockSize, block++) {
+        // Copied out of the columns, so no block gets split between two of their chunks
+        blockSize = min(KERNEL_LANES + block % KERNEL_LANES, columns.size() - firstPayment);
+        double hoursWorked[MAX_BLOCK_SIZE], regRates[MAX_BLOCK_SIZE];
+        PayrollPolicy payrollPolicies[MAX_BLOCK_SIZE], alternatingPayrollPolicies[MAX_BLOCK_SIZE];
+        for (size_t i = 0; i < blockSize; i++) {
+            hoursWorked[i] = columns.hoursWorked[firstPayment + i];
+            regRates[i] = columns.regRates[firstPayment + i];
+            payrollPolicies[i] = columns.payrollPolicies[firstPayment + i];
+            alternatingPayrollPolicies[i] = static_cast<PayrollPolicy>((block + i) % PAYROLL_POLICIES_AMOUNT);
+        }
+
+        const bool hasMixedPayrollPolicies = any_of(payrollPolicies, payrollPolicies + blockSize, [&](const PayrollPolicy policy) { return policy != payrollPolicies[0]; });
+        if (!hasMixedPayrollPolicies) verifyKernelsOverBlock(hoursWorked, regRates, payrollPolicies, blockSize, false);
+        verifyKernelsOverBlock(hoursWorked, regRates, payrollPolicies, blockSize, true);
+        verifyKernelsOverBlock(hoursWorked, regRates, alternatingPayrollPolicies, blockSize, true);
+    }
+
+    // And over all the payments at once, every kernel must add them up in exactly the same order
+    const PayrollReport scalarAddition = runKernel(accumulatePaymentColumnsScalar, 0, columns.size(), columns.hasMixedPayrollPolicies());
+    if (!areIdentical(createAdditionPayrollReport(columns), scalarAddition)) fail("The aggregation kernels do not agree with each other.");
+
+    // When all the payments follow the same payroll policy, the masked kernels must not change a thing
+    if (!columns.hasMixedPayrollPolicies() && !areIdentical(runKernel(accumulatePaymentColumnsScalar, 0, columns.size(), true), scalarAddition))
+        fail("The masked aggregation kernels do not agree with the specialised ones.");
+}
+
+// Fused report engine: builds a PayrollReportSummary, starting from a given (empty) report, over the figures of the payments that a given visitor passes to its callback
+template<typename Report, typename PaymentsVisitor>
+PayrollReportSummary<Report> summarizePayments(const Report &emptyReport, PaymentsVisitor visitPayments, const bool withDispersion) {
+    constexpr int FIELDS_AMOUNT = 6; // regHours, otHours, regPay, otPay, fica & socSec, in that order (the money in cents)
+    int paymentsAmount = 0;
+    PayrollReport sums; // The exact additions (the money adds up as whole cents)
+    double minimums[FIELDS_AMOUNT] {};
+    double maximums[FIELDS_AMOUNT] {};
+    double means[FIELDS_AMOUNT] {}; // Running means (Welford's method), only used for the standard deviation
+    double squaredDeviations[FIELDS_AMOUNT] {}; // Running sums of the squared deviations from the mean (Welford's method)
+
+    // The one & only pass over the payments: every derived figure gets computed once (by the visitor), & then added into every accumulator
+    visitPayments([&](const PaymentFigures &figures) {
+        paymentsAmount++;
+        addPaymentFiguresToPayrollReport(sums, figures); // Same order as the other builders, so the additions are identical to theirs
+
+        if (withDispersion) {
+            const double values[FIELDS_AMOUNT] = {figures.regHours, figures.otHours, static_cast<double>(figures.regPay.cents), static_cast<double>(figures.otPay.cents),
+                                                  static_cast<double>(figures.fica.cents), static_cast<double>(figures.socSec.cents)};
+            for (int i = 0; i < FIELDS_AMOUNT; i++) {
+                minimums[i] = paymentsAmount == 1 ? values[i] : min(minimums[i], values[i]);
+                maximums[i] = paymentsAmount == 1 ? values[i] : max(maximums[i], values[i]);
+                const double deviation = values[i] - means[i];
+                means[i] += deviation / paymentsAmount;
+                squaredDeviations[i] += deviation * (values[i] - means[i]);
+            }
+        }
+    });
+
+    // Turns a given array of field values into a PayrollReport (its money rounded to the cent)
+    const auto toPayrollReport = [paymentsAmount](const double (&fields)[FIELDS_AMOUNT]) {
+        return PayrollReport {.paymentsAmount = paymentsAmount, .regHours = fields[0], .otHours = fields[1], .regPay = Money::fromCents(fields[2]), .otPay = Money::fromCents(fields[3]),
+                              .fica = Money::fromCents(fields[4]), .socSec = Money::fromCents(fields[5])};
+    };
+
+    PayrollReportSummary<Report> summary {.addition = emptyReport, .average = emptyReport, .hasDispersion = withDispersion};
+    static_cast<PayrollReport &>(summary.addition) = sums; // Only the PayrollReport part, so the employee's data (if any) remains untouched
+    static_cast<PayrollReport &>(summary.average) = createAveragePayrollReportFromAddition(summary.addition);
+
+    if (withDispersion) {
+        double standardDeviations[FIELDS_AMOUNT] {};
+        for (int i = 0; i < FIELDS_AMOUNT; i++) {
+            standardDeviations[i] = paymentsAmount > 0 ? sqrt(squaredDeviations[i] / paymentsAmount) : 0.0;
+        }
+        summary.minimum = toPayrollReport(minimums);
+        summary.maximum = toPayrollReport(maximums);
+        summary.standardDeviation = toPayrollReport(standardDeviations);
+    }
+
+    return summary;
+}
+
+// Generates a EmployeePayrollReport with the addition of all the Payment structure variables related to a given employee
+EmployeePayrollReport createAdditionEmployeePayrollReport(const PaymentLedger &paymentLedger, const Employee &employee) {
+    EmployeePayrollReport theAdditionEmployeePayrollReport = createEmptyEmployeePayrollReport(paymentLedger, employee); // Gets associated to the employee
+
+    // An employee without payments has no entry in the index, so the report just stays empty
+    const auto indexIterator = paymentLedger.paymentPositionsByEmployeeId.find(employee.id);
+    if (indexIterator == paymentLedger.paymentPositionsByEmployeeId.end()) return theAdditionEmployeePayrollReport;
+
+    // And then we increase each respective field on each iteration (only over the employee's own payments), to leave it as an Addition EmployeePayrollReport
+    const PaymentColumns &columns = paymentLedger.columns;
+    for (const size_t position: indexIterator->second) {
+        addPaymentFiguresToPayrollReport(theAdditionEmployeePayrollReport, computePaymentFigures(columns.hoursWorked[position], columns.regRates[position], columns.payrollPolicies[position]));
+    }
+
+    return theAdditionEmployeePayrollReport;
+}
+
+// Generates a PayrollReport with the addition of all the Payment structure variables's data of the whole company across the time
+PayrollReport createAdditionPayrollReport(const vector<Payment> &payments) {
+    PayrollReport anAdditionPayrollReport; // Defined to be filled with data next
+
+    // And then we increase each respective field, to leave it as an Addition PayrollReport
+    for (const Payment &payment: payments) {
+        addPaymentToPayrollReport(anAdditionPayrollReport, payment);
+    }
+
+    return anAdditionPayrollReport;
+}
+
+// Generates a EmployeePayrollReport with the average of all the Payment structure variables related to a given employee
+EmployeePayrollReport createAverageEmployeePayrollReport(const PaymentLedger &paymentLedger, const Employee &employee) {
+    // The fused engine gets the average straight from its own single pass over the employee's payments
+    return createEmployeePayrollReportSummary(paymentLedger, employee).average;
+}
+
+// Generates a PayrollReport with the average of all the Payment structure variables's data of the whole company across the time
+PayrollReport createAveragePayrollReport(const vector<Payment> &payments) {
+    // We get a good old fashion & regular PayrollReport with addition data, of all the Payment structure variables's data of the whole company across the time,
+    // and then we average it (its payments amount is the same as the amount of payments in the vector)
+    return createAveragePayrollReportFromAddition(createAdditionPayrollReport(payments));
+}
+
+// Generates a PayrollReport with the average data of a given addition PayrollReport, by dividing each field by its payments amount
+PayrollReport createAveragePayrollReportFromAddition(const PayrollReport &additionPayrollReport) {
+    PAYROLL_TIME_OPERATION(CREATE_AVERAGE_PR_OPERATION);
+    PayrollReport anAveragePayrollReport = additionPayrollReport; // Same payments amount, but the rest of the fields get averaged next
+    const int paymentsAmount = additionPayrollReport.paymentsAmount;
+
+    // And now we must average/update each field, to leave it as an average PayrollReport (all of them 0, with no payments, just like the money ones)
+    anAveragePayrollReport.regHours = paymentsAmount > 0 ? additionPayrollReport.regHours / paymentsAmount : 0;
+    anAveragePayrollReport.otHours = paymentsAmount > 0 ? additionPayrollReport.otHours / paymentsAmount : 0;
+    anAveragePayrollReport.regPay = averageMoney(additionPayrollReport.regPay, paymentsAmount);
+    anAveragePayrollReport.otPay = averageMoney(additionPayrollReport.otPay, paymentsAmount);
+    anAveragePayrollReport.fica = averageMoney(additionPayrollReport.fica, paymentsAmount);
+    anAveragePayrollReport.socSec = averageMoney(additionPayrollReport.socSec, paymentsAmount);
+
+    return anAveragePayrollReport;
+}
+
+// Gets the average of a given addition of money among a given amount of payments, rounded to the cent (no money at all, when there are no payments)
+Money averageMoney(const Money addition, const int paymentsAmount) {
+    return paymentsAmount > 0 ? Money::fromCents(static_cast<double>(addition.cents) / paymentsAmount) : Money {};
+}
+
+// Recomputes from scratch the company's addition PayrollReport & aborts if it does not match exactly the running one kept by the PaymentLedger
+void verifyCompanyAdditionPayrollReport(const PaymentLedger &paymentLedger) {
+    const PaymentColumns &columns = paymentLedger.columns;
+    PayrollReport recomputed; // Rebuilt payment by payment, in their order (not through the kernels, which add them up in a different order)
+    for (size_t i = 0; i < columns.size(); i++) {
+        addPaymentFiguresToPayrollReport(recomputed, computePaymentFigures(columns.hoursWorked[i], columns.regRates[i], columns.payrollPolicies[i]));
+    }
+    const PayrollReport &running = paymentLedger.companyAdditionPayrollReport;
+
+    // Both were accumulated in the same order & with the same operations, so they must be identical (not just close)
+    const bool theyMatch = recomputed.paymentsAmount == running.paymentsAmount && recomputed.regHours == running.regHours && recomputed.otHours == running.otHours &&
+                           recomputed.regPay == running.regPay && recomputed.otPay == running.otPay && recomputed.fica == running.fica && recomputed.socSec == running.socSec;
+    if (!theyMatch) {
+        cerr << "The running company PayrollReport does not match the one recomputed from scratch." << endl;
+        abort();
+    }
+
+    // The kernels add the payments up in another order, but the money adds up exactly (as whole cents), so it must be identical too
+    const PayrollReport kernelsAddition = createAdditionPayrollReport(columns);
+    if (kernelsAddition.regPay != running.regPay || kernelsAddition.otPay != running.otPay || kernelsAddition.fica != running.fica || kernelsAddition.socSec != running.socSec) {
+        cerr << "The money added up by the aggregation kernels does not match the running company PayrollReport." << endl;
+        abort();
+    }
+}
+
+// Recomputes from scratch the PayDateIndex of a given PaymentLedger & aborts if it does not match exactly the one kept up to date, node by node
+void verifyPayDateIndex(const PaymentLedger &paymentLedger) {
+    const PayDateIndex recomputed = createPayDateIndex(paymentLedger.columns);
+    const PayDateIndex &running = paymentLedger.payDateIndex;
+
+    // Determines if two given PayrollReports are identical (both were accumulated in the same order & with the same operations, so not just close)
+    const auto areIdentical = [](const PayrollReport &a, const PayrollReport &b) {
+        return a.paymentsAmount == b.paymentsAmount && a.regHours == b.regHours && a.otHours == b.otHours && a.regPay == b.regPay && a.otPay == b.otPay &&
+               a.fica == b.fica && a.socSec == b.socSec;
+    };
+    const auto areAllIdentical = [&](const vector<PayrollReport> &a, const vector<PayrollReport> &b) {
+        return a.size() == b.size() && equal(a.begin(), a.end(), b.begin(), areIdentical);
+    };
+
+    // An empty ledger may have no tree at all yet
+    const bool theyMatch = recomputed.payDates == running.payDates && areAllIdentical(recomputed.additionsByPayDate, running.additionsByPayDate) &&
+                           (running.payDates.empty() || (recomputed.leavesCapacity == running.leavesCapacity && areAllIdentical(recomputed.tree, running.tree)));
+    if (!theyMatch) {
+        cerr << "The PayDateIndex does not match the one recomputed from scratch." << endl;
+        abort();
+    }
+}
+
+// Checks that the simulation of some given scenarios matches bit for bit the one of the portable kernel, & that the scenario with the current rules (the first one)
+// matches the company's running addition PayrollReport: its money exactly, & its hours closely (they add up in different orders). Aborts if not
+void verifyPayrollSimulation(const PaymentLedger &paymentLedger, const vector<PayrollScenario> &scenarios, const vector<PayrollReport> &simulatedReports) {
+    const PaymentColumns &columns = paymentLedger.columns;
+
+    // The portable kernel over every whole chunk, sequentially, but merged exactly like the parallel simulation does
+    vector<vector<PayrollReport>> partialReportsByScenario(scenarios.size(), vector<PayrollReport>(columns.hoursWorked.chunksAmount()));
+    for (size_t chunk = 0; chunk < columns.hoursWorked.chunksAmount(); chunk++) {
+        for (size_t scenario = 0; scenario < scenarios.size(); scenario++) {
+            simulatePaymentColumnsScalar(columns.hoursWorked.chunkData(chunk), columns.regRates.chunkData(chunk), columns.payrollPolicies.chunkData(chunk),
+                                         columns.hoursWorked.chunkSize(chunk), &scenarios[scenario], 1, &partialReportsByScenario[scenario][chunk]);
+        }
+    }
+
+    for (size_t scenario = 0; scenario < scenarios.size(); scenario++) {
+        const PayrollReport expected = reducePayrollReportsAsTree(partialReportsByScenario[scenario]);
+        const PayrollReport &simulated = simulatedReports[scenario];
+        const bool theyMatch = expected.paymentsAmount == simulated.paymentsAmount && expected.regHours == simulated.regHours && expected.otHours == simulated.otHours &&
+                               expected.regPay == simulated.regPay && expected.otPay == simulated.otPay && expected.fica == simulated.fica && expected.socSec == simulated.socSec;
+        if (!theyMatch) {
+            cerr << "The simulation of the scenario " << scenarios[scenario].name << " does not match the portable kernel." << endl;
+            abort();
+        }
+    }
+
+    // The money adds up exactly (as whole cents), so it must be identical no matter the order, while the hours only have to be close
+    const PayrollReport &running = paymentLedger.companyAdditionPayrollReport;
+    const auto areClose = [](const double a, const double b) { return fabs(a - b) <= 1e-9 * max(1.0, fabs(b)); };
+    if (!scenarios.empty() && (simulatedReports[0].regPay != running.regPay || simulatedReports[0].otPay != running.otPay || simulatedReports[0].fica != running.fica ||
+                               simulatedReports[0].socSec != running.socSec || !areClose(simulatedReports[0].regHours, running.regHours) ||
+                               !areClose(simulatedReports[0].otHours, running.otHours))) {
+        cerr << "The simulation with the current rules does not match the company's running PayrollReport." << endl;
+        abort();
+    }
+}
+
+// Prints on the terminal both EmployeePayrollReports, addition & average, of every employee that has received payments (current & ex employees)
+void generateAndPrintAllEmployeesPayrollReports(const PaymentLedger &paymentLedger) {
+    constexpr char BY_NET_PAY_OPTION = 'N';
+    constexpr char BY_TOTAL_HOURS_OPTION = 'H';
+    char orderSelection;
+
+    cout << endl;
+    cout << "-----------------------------------------------------------------" << endl;
+    cout << "     A L L   E M P L O Y E E S   P A Y R O L L   R E P O R T     " << endl;
+    cout << "-----------------------------------------------------------------" << endl;
+
+    do {
+        orderSelection = static_cast<char>(toupper(getAlphaChar("Sort the employees by their (N)et pay or by their total (H)ours")));
+        if (orderSelection != BY_NET_PAY_OPTION && orderSelection != BY_TOTAL_HOURS_OPTION)
+            cout << "The only available options are: " << BY_NET_PAY_OPTION << ", or " << BY_TOTAL_HOURS_OPTION << ". Try again." << endl;
+    } while (orderSelection != BY_NET_PAY_OPTION && orderSelection != BY_TOTAL_HOURS_OPTION);
+
+    // All the reports get generated together, in a single pass over all the payments
+    const EmployeeReportsOrder order = orderSelection == BY_NET_PAY_OPTION ? BY_NET_PAY : BY_TOTAL_HOURS;
+    const vector<PayrollReportSummary<EmployeePayrollReport>> allEmployeesPayrollReportSummaries = createAllEmployeesPayrollReportSummaries(paymentLedger, order);
+
+    // And now we can finally send them to print
+    printAllEmployeesPayrollReports(allEmployeesPayrollReportSummaries);
+}
+
+// Prints on the terminal both PayrollReports, addition & average, of the company's payments within a range of pay dates, a quarter or the year to date
+void generateAndPrintPayDatesPayrollReports(const PaymentLedger &paymentLedger) {
+    constexpr char BY_RANGE_OPTION = 'R';
+    constexpr char BY_QUARTER_OPTION = 'Q';
+    constexpr char YEAR_TO_DATE_OPTION = 'Y';
+    char rangeSelection;
+
+#ifdef PAYROLL_VERIFY_AGGREGATES
+    // When verifying, the pay dates' additions (& every node over them) must match exactly the ones rebuilt from scratch
+    verifyPayDateIndex(paymentLedger);
+#endif
+
+    cout << endl;
+    cout << "-----------------------------------------------------------------" << endl;
+    cout << "       P A Y   P E R I O D S   P A Y R O L L   R E P O R T       " << endl;
+    cout << "-----------------------------------------------------------------" << endl;
+
+    do {
+        rangeSelection = static_cast<char>(toupper(getAlphaChar("Report a (R)ange of pay dates, a (Q)uarter or the (Y)ear to date")));
+        if (rangeSelection != BY_RANGE_OPTION && rangeSelection != BY_QUARTER_OPTION && rangeSelection != YEAR_TO_DATE_OPTION)
+            cout << "The only available options are: " << BY_RANGE_OPTION << ", " << BY_QUARTER_OPTION << ", or " << YEAR_TO_DATE_OPTION << ". Try again." << endl;
+    } while (rangeSelection != BY_RANGE_OPTION && rangeSelection != BY_QUARTER_OPTION && rangeSelection != YEAR_TO_DATE_OPTION);
+
+    // Whatever the choice, it ends up as a range of pay dates (both included)
+    int32_t firstPayDate, lastPayDate;
+    if (rangeSelection == BY_RANGE_OPTION) {
+        firstPayDate = getIsoDate("Type the first pay date of the range");
+        lastPayDate = getIsoDate("Type the last pay date of the range");
+        if (lastPayDate < firstPayDate) swap(firstPayDate, lastPayDate); // Typed the other way around
+    } else if (rangeSelection == BY_QUARTER_OPTION) {
+        const auto year = static_cast<int>(getDouble("Type the year of the quarter", 1, 9999, true));
+        const auto quarter = static_cast<int>(getDouble("Type the quarter", 1, 4, true));
+        getQuarterDates(year, quarter, firstPayDate, lastPayDate);
+    } else {
+        lastPayDate = getTodaysDate();
+        firstPayDate = getFirstDateOfYear(lastPayDate);
+    }
+
+    // The addition PayrollReport comes straight from the pay dates' tree, & the average one gets derived from it in constant time
+    const PayrollReport additionPayrollReport = createAdditionPayrollReportOfPayDates(paymentLedger, firstPayDate, lastPayDate);
+    const PayrollReport averagePayrollReport = createAveragePayrollReportFromAddition(additionPayrollReport);
+
+    // And now we can finally send both to print
+    printPayDatesPayrollReports(firstPayDate, lastPayDate, additionPayrollReport, averagePayrollReport);
+}
+
+// Prints on the console both, the addition & average PayrollReports of the company
+void printCompanyPayrollReports(const PayrollReport &additionPR, const PayrollReport &averagePR) {
+    PAYROLL_TIME_OPERATION(PRINT_COMPANY_PR_OPERATION);
+    cout << endl;
+    cout << "The company has made " << additionPR.paymentsAmount << " payment" << (additionPR.paymentsAmount == 1 ? "" : "s") << "." << endl;
+    printPayrollReportsTable(additionPR, averagePR);
+}
+
+// Prints on the console both, the addition & average PayrollReports of the company's payments within a given range of pay dates (both included)
+void printPayDatesPayrollReports(const int32_t firstPayDate, const int32_t lastPayDate, const PayrollReport &additionPR, const PayrollReport &averagePR) {
+    PAYROLL_TIME_OPERATION(PRINT_PAY_DATES_PR_OPERATION);
+    cout << endl;
+    if (additionPR.paymentsAmount == 0) {
+        cout << "The company has not made any payment with a pay date from " << isoDateToString(firstPayDate) << " to " << isoDateToString(lastPayDate) << "." << endl;
+        return;
+    }
+    cout << "From " << isoDateToString(firstPayDate) << " to " << isoDateToString(lastPayDate) << ", the company has made " << additionPR.paymentsAmount << " payment" << (additionPR.paymentsAmount == 1 ? "" : "s") << "." << endl;
+    printPayrollReportsTable(additionPR, averagePR);
+}
+
+// Prints on the console both, the addition & average given EmployeePayrollReports
+void printEmployeePayrollReports(const EmployeePayrollReport &additionEPR, const EmployeePayrollReport &averageEPR) {
+    PAYROLL_TIME_OPERATION(PRINT_EPR_OPERATION);
+    cout << endl;
+    cout << "The employee " << additionEPR.fullName() << ", with ID " << employeeIdToString(additionEPR.employeeId) << " has received " << additionEPR.paymentsAmount << " payment" << (additionEPR.paymentsAmount == 1 ? "" : "s") << "." << endl;
+    printPayrollReportsTable(additionEPR, averageEPR);
+}
+
+// Prints on the console a table with the addition & average figures of a given batch of EmployeePayrollReports, one employee per row
+void printAllEmployeesPayrollReports(const vector<PayrollReportSummary<EmployeePayrollReport>> &employeePayrollReportSummaries) {
+    PAYROLL_TIME_OPERATION(PRINT_ALL_EPR_OPERATION);
+    // Finds the length of the employee with the largest full name
+    int largestFullNameLength = FULL_NAME_TITLE_LENGTH; // At least as wide as the "Full Name" title
+    for (const PayrollReportSummary<EmployeePayrollReport> &summary: employeePayrollReportSummaries) {
+        largestFullNameLength = max(largestFullNameLength, static_cast<int>(summary.addition.fullName().size()));
+    }
+
+    // The figures of each row (the hours with 2 decimals, & the rest as money), in the same order as the columns after the Unique ID
+    constexpr size_t FIGURES_AMOUNT = 7;
+    constexpr array<string_view, FIGURES_AMOUNT> FIGURE_TITLES {"Payments", "Total Hrs", "Avg Hrs", "  Total Pay  ", "Avg Total Pay", "   Net Pay   ", " Avg Net Pay "};
+    const auto getFigures = [](const PayrollReportSummary<EmployeePayrollReport> &summary) {
+        const EmployeePayrollReport &addition = summary.addition;
+        const EmployeePayrollReport &average = summary.average;
+        return array<double, FIGURES_AMOUNT> {static_cast<double>(addition.paymentsAmount), addition.regHours + addition.otHours, average.regHours + average.otHours,
+                                              addition.totalPay().dollars(), average.totalPay().dollars(), addition.netPay().dollars(), average.netPay().dollars()};
+    };
+    const auto getFigureLength = [](const size_t figure, const double value) {
+        char text[FORMATTED_NUMBER_CAPACITY];
+        if (figure == 0) return static_cast<int>(to_chars(text, text + sizeof(text), static_cast<unsigned long long>(value)).ptr - text);
+        if (figure <= 2) return static_cast<int>(to_chars(text, text + sizeof(text), value, chars_format::fixed, 2).ptr - text);
+        return static_cast<int>(formatMoney(text, text + sizeof(text), value) - text);
+    };
+
+    // Every column is as wide as its title, or as its widest figure (so no figure ever breaks the table, however big it gets)
+    array<int, FIGURES_AMOUNT> figureWidths {};
+    for (size_t figure = 0; figure < FIGURES_AMOUNT; figure++) figureWidths[figure] = static_cast<int>(FIGURE_TITLES[figure].size());
+    for (const PayrollReportSummary<EmployeePayrollReport> &summary: employeePayrollReportSummaries) {
+        const array<double, FIGURES_AMOUNT> figures = getFigures(summary);
+        for (size_t figure = 0; figure < FIGURES_AMOUNT; figure++) figureWidths[figure] = max(figureWidths[figure], getFigureLength(figure, figures[figure]));
+    }
+    int tableWidth = largestFullNameLength + 4 + static_cast<int>(EMPLOYEE_ID_TEXT_LENGTH) + 3;
+    for (const int figureWidth: figureWidths) tableWidth += figureWidth + 3;
+
+    cout << endl;
+    cout << employeePayrollReportSummaries.size() << " employee" << (employeePayrollReportSummaries.size() == 1 ? " has" : "s have") << " received payments." << endl;
+
+    // The line under each row is always the same, so it gets built only once
+    cout << fixed << setprecision(2); // Before the renderer, which follows the stream's format
+    TableRenderer tableRenderer(cout);
+    const string lineUnderRow = renderLineUnderEmployeesPayrollReportsTableRow(tableWidth);
+
+    // Table Header
+    tableRenderer.appendText(lineUnderRow);
+    tableRenderer.appendText("| Full Name ");
+    tableRenderer.appendPadding(largestFullNameLength - FULL_NAME_TITLE_LENGTH);
+    tableRenderer.appendText(" |                Unique ID             |");
+    for (size_t figure = 0; figure < FIGURES_AMOUNT; figure++) {
+        tableRenderer.appendText(" ");
+        tableRenderer.appendPadding(figureWidths[figure] - static_cast<int>(FIGURE_TITLES[figure].size()));
+        tableRenderer.appendText(FIGURE_TITLES[figure]);
+        tableRenderer.appendText(" |");
+    }
+    tableRenderer.endLine();
+    tableRenderer.appendText(lineUnderRow);
+
+    // Each one of the rows
+    for (const PayrollReportSummary<EmployeePayrollReport> &summary: employeePayrollReportSummaries) {
+        const string_view fullName = summary.addition.fullName();
+        const array<double, FIGURES_AMOUNT> figures = getFigures(summary);
+        tableRenderer.appendText("| ");
+        tableRenderer.appendText(fullName);
+        tableRenderer.appendPadding(largestFullNameLength - static_cast<int>(fullName.size()));
+        tableRenderer.appendText(" | ");
+        tableRenderer.appendEmployeeId(summary.addition.employeeId);
+        tableRenderer.appendText(" | ");
+        tableRenderer.appendInteger(summary.addition.paymentsAmount, figureWidths[0]);
+        for (size_t figure = 1; figure < FIGURES_AMOUNT; figure++) {
+            tableRenderer.appendText(" | ");
+            if (figure <= 2) tableRenderer.appendNumber(figures[figure], figureWidths[figure]);
+            else tableRenderer.appendMoney(figures[figure], figureWidths[figure]);
+        }
+        tableRenderer.appendText(" |");
+        tableRenderer.endLine();
+        tableRenderer.appendText(lineUnderRow);
+    }
+}
+
+// Renders an appropiate length "line" conformed by dashes (& its line break), of a given table width, as part of a good looking table of EmployeePayrollReports
+string renderLineUnderEmployeesPayrollReportsTableRow(const int tableWidth) {
+    return string(max(0, tableWidth), '-') + "\n";
+}
+
+// Prints either a EmployeePayrollReport or a PayrollReport structure variable, with addition and average data,
+// as we pass as argument a father struct PayrollReport variable, and from the received parameter we won't use the employee's id anyway at this point (either done before or not needed)
+void printPayrollReportsTable(const PayrollReport &additionPR, const PayrollReport &averagePR) {
+    constexpr int MAX_ROW_WIDTH = 50; // We set the overall width of the table based on this precisely. The columns must fit inside
+    constexpr int ADDITION_COL_INNER_WIDTH = 12; // To customize the width of the Addition Column, so it looks good later
+    constexpr int AVERAGE_COL_INNER_WIDTH = 11; // To customize the width of the Average Column, so it looks good later
+
+    printNTimesAndBreak("-", MAX_ROW_WIDTH);
+    cout << "|       Field       |   Addition   |   Average   |" << endl;
+    printNTimesAndBreak("-", MAX_ROW_WIDTH);
+    cout << "|  Regular Hours    | " << setw(ADDITION_COL_INNER_WIDTH) << left << additionPR.regHours << " | " << setw(AVERAGE_COL_INNER_WIDTH) << left << averagePR.regHours << " |" << endl;
+    printNTimesAndBreak("-", MAX_ROW_WIDTH);
+    cout << "|  Overtime Hours   | " << setw(ADDITION_COL_INNER_WIDTH) << left << additionPR.otHours << " | " << setw(AVERAGE_COL_INNER_WIDTH) << left << averagePR.otHours << " |" << endl;
+    printNTimesAndBreak("-", MAX_ROW_WIDTH);
+    cout << "|  Regular Pay      | " << setw(ADDITION_COL_INNER_WIDTH) << left << monetizeDouble(additionPR.regPay.dollars()) << " | " << setw(AVERAGE_COL_INNER_WIDTH) << left << monetizeDouble(averagePR.regPay.dollars()) << " |" << endl;
+    printNTimesAndBreak("-", MAX_ROW_WIDTH);
+    cout << "|  Overtime Pay     | " << setw(ADDITION_COL_INNER_WIDTH) << left << monetizeDouble(additionPR.otPay.dollars()) << " | " << setw(AVERAGE_COL_INNER_WIDTH) << left << monetizeDouble(averagePR.otPay.dollars()) << " |" << endl;
+    printNTimesAndBreak("-", MAX_ROW_WIDTH);
+    cout << "|       FICA        | " << setw(ADDITION_COL_INNER_WIDTH) << left << monetizeDouble(additionPR.fica.dollars()) << " | " << setw(AVERAGE_COL_INNER_WIDTH) << left << monetizeDouble(averagePR.fica.dollars()) << " |" << endl;
+    printNTimesAndBreak("-", MAX_ROW_WIDTH);
+    cout << "|  Social Security  | " << setw(ADDITION_COL_INNER_WIDTH) << left << monetizeDouble(additionPR.socSec.dollars()) << " | " << setw(AVERAGE_COL_INNER_WIDTH) << left << monetizeDouble(averagePR.socSec.dollars()) << " |" << endl;
+    printNTimesAndBreak("-", MAX_ROW_WIDTH);
+    cout << "|     Total Pay     | " << setw(ADDITION_COL_INNER_WIDTH) << left << monetizeDouble(additionPR.totalPay().dollars()) << " | " << setw(AVERAGE_COL_INNER_WIDTH) << left << monetizeDouble(averagePR.totalPay().dollars()) << " |" << endl;
+    printNTimesAndBreak("-", MAX_ROW_WIDTH);
+    cout << "|  Total Deductions | " << setw(ADDITION_COL_INNER_WIDTH) << left << monetizeDouble(additionPR.totDeductions().dollars()) << " | " << setw(AVERAGE_COL_INNER_WIDTH) << left << monetizeDouble(averagePR.totDeductions().dollars()) << " |" << endl;
+    printNTimesAndBreak("-", MAX_ROW_WIDTH);
+    cout << "|      Net Pay      | " << setw(ADDITION_COL_INNER_WIDTH) << left << monetizeDouble(additionPR.netPay().dollars()) << " | " << setw(AVERAGE_COL_INNER_WIDTH) << left << monetizeDouble(averagePR.netPay().dollars()) << " |" << endl;
+    printNTimesAndBreak("-", MAX_ROW_WIDTH);
+}
+
+// Prints on the terminal the comparison of a given scenario's addition PayrollReport with the current one
+void printPayrollScenarioComparisonTable(TableRenderer &tableRenderer, const PayrollScenario &scenario, const PayrollReport &current, const PayrollReport &simulated) {
+    PAYROLL_TIME_OPERATION(PRINT_SCENARIO_COMPARISON_OPERATION);
+    constexpr int VALUE_COL_INNER_WIDTH = 18; // To customize the width of the Current, Scenario & Difference columns, so they look good later
+    const string lineUnderRow = string(20 + 3 * (VALUE_COL_INNER_WIDTH + 3), '-') + "\n";
+    const PayrollRules &standardRules = scenario.rulesByPolicy[STANDARD_PAYROLL_POLICY];
+
+    // The scenario's name & its rules, right above its table
+    tableRenderer.endLine();
+    tableRenderer.appendText("Scenario ");
+    tableRenderer.appendText(scenario.name);
+    tableRenderer.appendText(": up to");
+    tableRenderer.appendNumber(standardRules.maxRegHours, 6);
+    tableRenderer.appendText(" regular hours, overtime paid at");
+    tableRenderer.appendNumber(standardRules.otMultiplier, 5);
+    tableRenderer.appendText("x, FICA at");
+    tableRenderer.appendNumber(standardRules.ficaRate * 100, 6);
+    tableRenderer.appendText("% & social security at");
+    tableRenderer.appendNumber(standardRules.ssMedRate * 100, 6);
+    tableRenderer.appendText("%");
+    tableRenderer.endLine();
+
+    tableRenderer.appendText(lineUnderRow);
+    tableRenderer.appendText("|       Field       |      Current       |      Scenario      |     Difference     |");
+    tableRenderer.endLine();
+    tableRenderer.appendText(lineUnderRow);
+
+    // Each one of the rows: the hours as numbers, & the rest as money (whose difference is exact, in cents)
+    const auto appendRow = [&](const string_view fieldName, const auto currentValue, const auto simulatedValue) {
+        tableRenderer.appendText(fieldName);
+        for (const auto value: {currentValue, simulatedValue, simulatedValue - currentValue}) {
+            tableRenderer.appendText(" ");
+            if constexpr (is_same_v<decltype(value), const Money>) tableRenderer.appendMoney(value.dollars(), VALUE_COL_INNER_WIDTH);
+            else tableRenderer.appendNumber(value, VALUE_COL_INNER_WIDTH);
+            tableRenderer.appendText(" |");
+        }
+        tableRenderer.endLine();
+        tableRenderer.appendText(lineUnderRow);
+    };
+    appendRow("|  Regular Hours    |", current.regHours, simulated.regHours);
+    appendRow("|  Overtime Hours   |", current.otHours, simulated.otHours);
+    appendRow("|  Regular Pay      |", current.regPay, simulated.regPay);
+    appendRow("|  Overtime Pay     |", current.otPay, simulated.otPay);
+    appendRow("|       FICA        |", current.fica, simulated.fica);
+    appendRow("|  Social Security  |", current.socSec, simulated.socSec);
+    appendRow("|     Total Pay     |", current.totalPay(), simulated.totalPay());
+    appendRow("|  Total Deductions |", current.totDeductions(), simulated.totDeductions());
+    appendRow("|      Net Pay      |", current.netPay(), simulated.netPay());
+}
+
+// Prints on the console goodbyes to the user
+void sayGoodbyeToTheUser() {
+    cout << endl;
+    cout << "Than you for using our services. " << endl;
+    cout << "Payroll Pro 20.0, Copyright © 2024 https://www.reiniergarcia.dev/" << endl;
+    cout << "Goodbye!" << endl;
+}
+
+#ifdef PAYROLL_INSTRUMENTATION
+// Counts every allocation of the calling thread, so the operations being timed can tell how many they made (the arrays ones come through here too)
+void *operator new(const size_t size) {
+    threadAllocations++;
+    threadAllocatedBytes += size;
+    if (void *const memory = malloc(size == 0 ? 1 : size)) return memory;
+    throw bad_alloc();
+}
+
+// Never inlined, so the compiler doesn't pair the free() with the new expressions (they do end up in malloc(), through the operator new above)
+__attribute__((noinline)) void operator delete(void *const memory) noexcept {
+    free(memory);
+}
+
+__attribute__((noinline)) void operator delete(void *const memory, size_t) noexcept {
+    free(memory);
+}
+
+ScopedOperationTimer::ScopedOperationTimer(const InstrumentedOperation operation)
+    : operation(operation), firstAllocations(threadAllocations), firstAllocatedBytes(threadAllocatedBytes), startTime(chrono::steady_clock::now()) {
+}
+
+ScopedOperationTimer::~ScopedOperationTimer() {
+    const auto nanoseconds = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - startTime).count();
+    recordOperationCall(operation, static_cast<uint64_t>(nanoseconds), threadAllocations - firstAllocations, threadAllocatedBytes - firstAllocatedBytes);
+}
+
+InstrumentationReportOnExit::~InstrumentationReportOnExit() {
+    printInstrumentationTable(cerr); // The standard output may be carrying JSON lines (in the headless mode)
+    if (jsonPath.empty()) return;
+    ofstream jsonFile(jsonPath, ios::binary | ios::trunc);
+    jsonFile << renderInstrumentationJson() << '\n';
+    if (!jsonFile) cerr << "The instrumentation's statistics could not be written to " << jsonPath << "." << endl;
+}
+
+// Adds a given amount of events to a given InstrumentedCounter
+void countInstrumentedEvents(const InstrumentedCounter counter, const uint64_t amount) {
+    instrumentationStats.counters[counter].fetch_add(amount, memory_order_relaxed);
+}
+
+// Adds one call of a given InstrumentedOperation, with its latency in nanoseconds & its allocations, to the instrumentation's statistics
+void recordOperationCall(const InstrumentedOperation operation, const uint64_t nanoseconds, const uint64_t allocations, const uint64_t allocatedBytes) {
+    OperationStats &stats = instrumentationStats.operations[operation];
+    stats.calls.fetch_add(1, memory_order_relaxed);
+    stats.totalNanoseconds.fetch_add(nanoseconds, memory_order_relaxed);
+    stats.allocations.fetch_add(allocations, memory_order_relaxed);
+    stats.allocatedBytes.fetch_add(allocatedBytes, memory_order_relaxed);
+    stats.latencyBuckets[getLatencyBucket(nanoseconds)].fetch_add(1, memory_order_relaxed);
+    for (uint64_t maxNanoseconds = stats.maxNanoseconds.load(memory_order_relaxed); maxNanoseconds < nanoseconds;) {
+        if (stats.maxNanoseconds.compare_exchange_weak(maxNanoseconds, nanoseconds, memory_order_relaxed)) break;
+    }
+}
+
+// Gets the latency bucket of a given amount of nanoseconds: exact below 8, & then 4 buckets per power of 2
+size_t getLatencyBucket(const uint64_t nanoseconds) {
+    constexpr uint64_t SUB_BUCKETS = 1 << LATENCY_SUB_BUCKETS_BITS;
+    if (nanoseconds < SUB_BUCKETS) return nanoseconds;
+
+    // The highest bit picks the power of 2, & the next ones the sub-bucket within it
+    const int highestBit = 63 - __builtin_clzll(nanoseconds);
+    const uint64_t subBucket = (nanoseconds >> (highestBit - LATENCY_SUB_BUCKETS_BITS)) & (SUB_BUCKETS - 1);
+    return (highestBit - LATENCY_SUB_BUCKETS_BITS + 1) * SUB_BUCKETS + subBucket;
+}
+
+// Gets the largest amount of nanoseconds that falls into a given latency bucket
+uint64_t getLatencyBucketUpperBound(const size_t bucket) {
+    constexpr size_t SUB_BUCKETS = 1 << LATENCY_SUB_BUCKETS_BITS;
+    if (bucket < SUB_BUCKETS) return bucket;
+
+    const size_t powerOf2 = bucket / SUB_BUCKETS - 1; // How many times the sub-buckets have been doubled
+    const uint64_t nextBucketStart = static_cast<uint64_t>(SUB_BUCKETS + bucket % SUB_BUCKETS + 1) << powerOf2;
+    return nextBucketStart == 0 ? UINT64_MAX : nextBucketStart - 1; // The last bucket ends right at the largest 64 bits value
+}
+
+// Estimates a given percentile (from 0 to 1) of the latencies of a given OperationStats, from its buckets (never above its maximum)
+uint64_t estimateLatencyPercentile(const OperationStats &stats, const double percentile) {
+    const uint64_t calls = stats.calls.load(memory_order_relaxed);
+    const auto rank = max<uint64_t>(1, static_cast<uint64_t>(ceil(percentile * static_cast<double>(calls)))); // Of the call at the percentile, from the fastest one
+    uint64_t callsSoFar = 0;
+    for (size_t bucket = 0; bucket < LATENCY_BUCKETS_AMOUNT; bucket++) {
+        callsSoFar += stats.latencyBuckets[bucket].load(memory_order_relaxed);
+        if (callsSoFar >= rank) return min(getLatencyBucketUpperBound(bucket), stats.maxNanoseconds.load(memory_order_relaxed));
+    }
+    return stats.maxNanoseconds.load(memory_order_relaxed);
+}
+
+// Prints on a given stream the instrumentation's statistics, as a table with a row per operation called (& then the counters)
+void printInstrumentationTable(ostream &output) {
+    constexpr int OPERATION_COL_WIDTH = 46;
+    constexpr int NUMBER_COL_WIDTH = 12;
+    constexpr double NANOSECONDS_PER_MICROSECOND = 1000.0;
+    const string lineUnderRow = string(OPERATION_COL_WIDTH + 4 + 9 * (NUMBER_COL_WIDTH + 3) - 1, '-') + "\n";
+
+    output << endl << fixed << setprecision(1); // Before the renderer, which follows the stream's format
+    TableRenderer tableRenderer(output);
+    tableRenderer.appendText("Instrumentation (latencies in microseconds, allocations of the calling thread; nested operations included):");
+    tableRenderer.endLine();
+    tableRenderer.appendText(lineUnderRow);
+    tableRenderer.appendText("| Operation");
+    tableRenderer.appendPadding(OPERATION_COL_WIDTH - 9);
+    for (const string_view columnName: {"Calls", "Total", "Mean", "p50", "p90", "p99", "Max", "Allocations", "KiB"}) {
+        tableRenderer.appendText(" | ");
+        tableRenderer.appendPadding(NUMBER_COL_WIDTH - static_cast<int>(columnName.size()));
+        tableRenderer.appendText(columnName);
+    }
+    tableRenderer.appendText(" |");
+    tableRenderer.endLine();
+    tableRenderer.appendText(lineUnderRow);
+
+    for (int operation = 0; operation < INSTRUMENTED_OPERATIONS_AMOUNT; operation++) {
+        const OperationStats &stats = instrumentationStats.operations[operation];
+        const uint64_t calls = stats.calls.load(memory_order_relaxed);
+        if (calls == 0) continue; // Only the operations that actually ran
+
+        const double totalMicroseconds = stats.totalNanoseconds.load(memory_order_relaxed) / NANOSECONDS_PER_MICROSECOND;
+        tableRenderer.appendText("| ");
+        tableRenderer.appendText(INSTRUMENTED_OPERATION_NAMES[operation]);
+        tableRenderer.appendPadding(OPERATION_COL_WIDTH - static_cast<int>(INSTRUMENTED_OPERATION_NAMES[operation].size()));
+        const auto appendCount = [&](const uint64_t count) { // The counts as integers, & the rest with a decimal
+            const string humanizedCount = humanizeUnsignedInteger(count);
+            tableRenderer.appendText(" | ");
+            tableRenderer.appendPadding(NUMBER_COL_WIDTH - static_cast<int>(humanizedCount.size()));
+            tableRenderer.appendText(humanizedCount);
+        };
+        appendCount(calls);
+        const double latencies[] = {
+            totalMicroseconds, totalMicroseconds / static_cast<double>(calls), estimateLatencyPercentile(stats, 0.5) / NANOSECONDS_PER_MICROSECOND,
+            estimateLatencyPercentile(stats, 0.9) / NANOSECONDS_PER_MICROSECOND, estimateLatencyPercentile(stats, 0.99) / NANOSECONDS_PER_MICROSECOND,
+            stats.maxNanoseconds.load(memory_order_relaxed) / NANOSECONDS_PER_MICROSECOND
+        };
+        for (const double latency: latencies) {
+            tableRenderer.appendText(" | ");
+            tableRenderer.appendNumber(latency, NUMBER_COL_WIDTH);
+        }
+        appendCount(stats.allocations.load(memory_order_relaxed));
+        tableRenderer.appendText(" | ");
+        tableRenderer.appendNumber(stats.allocatedBytes.load(memory_order_relaxed) / 1024.0, NUMBER_COL_WIDTH);
+        tableRenderer.appendText(" |");
+        tableRenderer.endLine();
+        tableRenderer.appendText(lineUnderRow);
+    }
+
+    // The counters go right below, in a single line
+    tableRenderer.appendText("Counters:");
+    for (int counter = 0; counter < INSTRUMENTED_COUNTERS_AMOUNT; counter++) {
+        tableRenderer.appendText(counter == 0 ? " " : ", ");
+        tableRenderer.appendText(INSTRUMENTED_COUNTER_NAMES[counter]);
+        tableRenderer.appendText(" = ");
+        tableRenderer.appendText(humanizeUnsignedInteger(instrumentationStats.counters[counter].load(memory_order_relaxed)));
+    }
+    tableRenderer.endLine();
+}
+
+// Renders the instrumentation's statistics as a JSON object, with every operation called & every counter
+string renderInstrumentationJson() {
+    string json = "{\"operations\":[";
+    for (int operation = 0; operation < INSTRUMENTED_OPERATIONS_AMOUNT; operation++) {
+        const OperationStats &stats = instrumentationStats.operations[operation];
+        const uint64_t calls = stats.calls.load(memory_order_relaxed);
+        if (calls == 0) continue; // Only the operations that actually ran
+
+        const pair<const char *, uint64_t> fields[] = {
+            {"calls", calls}, {"totalNs", stats.totalNanoseconds.load(memory_order_relaxed)}, {"p50Ns", estimateLatencyPercentile(stats, 0.5)},
+            {"p90Ns", estimateLatencyPercentile(stats, 0.9)}, {"p99Ns", estimateLatencyPercentile(stats, 0.99)}, {"maxNs", stats.maxNanoseconds.load(memory_order_relaxed)},
+            {"allocations", stats.allocations.load(memory_order_relaxed)}, {"allocatedBytes", stats.allocatedBytes.load(memory_order_relaxed)}
+        };
+        if (json.back() != '[') json += ',';
+        json += "{\"name\":";
+        appendJsonString(json, INSTRUMENTED_OPERATION_NAMES[operation]);
+        for (const auto &[name, value]: fields) {
+            json += ",\"";
+            json += name;
+            json += "\":";
+            json += to_string(value);
+        }
+        json += '}';
+    }
+
+    json += "],\"counters\":{";
+    for (int counter = 0; counter < INSTRUMENTED_COUNTERS_AMOUNT; counter++) {
+        if (counter > 0) json += ',';
+        appendJsonString(json, INSTRUMENTED_COUNTER_NAMES[counter]);
+        json += ':';
+        json += to_string(instrumentationStats.counters[counter].load(memory_order_relaxed));
+    }
+    json += "}}";
+    return json;
+}
+#endif
@@ -0,0 +1,1459 @@
+/**
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                   *
+ *   Payroll Pro 2.0 - The payroll core                              *
+ *                                                                   *
+ *   Purpose:                                                        *
+ *   The constants, structures & prototypes of everything but the    *
+ *   main function, so both the program (main.cpp) & the benchmarks  *
+ *   (bench/payroll_bench.cpp) get built on the payroll library.     *
+ *                                                                   *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ **/
+
+#ifndef PAYROLL_PRO_PAYROLL_H
+#define PAYROLL_PRO_PAYROLL_H
+
+#include <iostream>
+#include <string>
+#include <iomanip>
+#include<random>
+#include <sstream>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <fstream>
+#include <filesystem>
+#include <string_view>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <charconv>
+#include <memory>
+#include <ctime>
+#include <type_traits>
+
+// The AVX2 aggregation kernels are only compiled on x86-64 with GCC or Clang (they get picked at runtime, only if the CPU supports them). Their intrinsics stay inside payroll.cpp
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define PAYROLL_HAS_AVX2_KERNELS
+#endif
+
+// The kernels must match each other (& the Payment's member functions) bit for bit, & the reports must not depend on the amount of workers, so no floating point operation may be
+// reordered, contracted or assumed finite. -ffast-math allows all of that
+#ifdef __FAST_MATH__
+#error "The payroll core relies on strict IEEE 754 arithmetic, so it can't be built with -ffast-math"
+#endif
+
+// The hot-path instrumentation (scoped timers, counters & allocation counts) only gets compiled in with PAYROLL_INSTRUMENTATION. Otherwise its macros expand to nothing at all
+#ifdef PAYROLL_INSTRUMENTATION
+#define PAYROLL_TIME_OPERATION(operation) const ScopedOperationTimer scopedOperationTimer(operation)
+#define PAYROLL_COUNT(counter, amount) countInstrumentedEvents(counter, amount)
+#else
+#define PAYROLL_TIME_OPERATION(operation)
+#define PAYROLL_COUNT(counter, amount)
+#endif
+
+/**
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                         *
+ *                   GLOBAL CONSTANTS                      *
+ *                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ **/
+
+constexpr int MAX_REG_HOURS = 40;
+constexpr int MAX_HOURS_WORKED = 50;
+constexpr double MIN_HOURLY_WAGE = 10.00;
+constexpr double MAX_HOURLY_WAGE = 30.00;
+constexpr double FICA_RATE = .20;
+constexpr double SS_MED_RATE = .0765;
+constexpr double OT_MULT = 1.5;
+constexpr double MAX_SIMULATED_OT_MULT = 5.0; // The largest overtime multiplier a what-if scenario may simulate
+
+constexpr int KERNEL_LANES = 4; // The aggregation kernels accumulate every 4th payment into the same lane (the width of an AVX2 register of doubles)
+constexpr int KERNEL_HOURS_FIELDS = 2; // regHours & otHours, in that order
+constexpr int KERNEL_MONEY_FIELDS = 4; // regPay, otPay, fica & socSec, in that order
+constexpr double MAX_ROUNDED_CENTS = 0x1p51 - 1; // The largest amount of cents (in magnitude) that money gets rounded from. Larger amounts (& NaN) saturate to it first
+constexpr double CENTS_ROUNDING_SHIFTER = 0x1.8p52; // Adding it to a whole amount of cents (up to MAX_ROUNDED_CENTS in magnitude) leaves it right in the low bits of the mantissa
+constexpr size_t PARALLEL_REPORT_CHUNK_SIZE = 65536; // Payments per chunk of a parallel report. It never depends on the amount of threads, so neither do the results
+constexpr unsigned MAX_REPORT_WORKERS = 256; // The most report workers that --report-workers may ask for (more would just be idle threads, as the chunks are that big)
+constexpr size_t SIMULATION_TILE_SIZE = 4096; // Payments that every what-if scenario goes through before the next ones (so they stay in the cache meanwhile)
+constexpr size_t SIMULATION_SCENARIOS_PER_TASK = 64; // What-if scenarios simulated by each task over its chunk of payments (so even a single chunk gets parallelised)
+
+constexpr char LEDGER_FILE_MAGIC[8] = {'P', 'A', 'Y', 'R', 'O', 'L', 'L', '\0'}; // The first 8 bytes of every ledger file
+constexpr uint32_t LEDGER_FILE_VERSION = 6; // Increased on every change of the ledger file's layout
+constexpr uint32_t DOLLARS_REPORT_LEDGER_FILE_VERSION = 5; // The last version with the money of the header's report in dollars (as doubles). It still gets opened, & migrated
+constexpr const char *DEFAULT_LEDGER_FILE_PATH = "payroll.ledger";
+constexpr const char *WRITE_AHEAD_LOG_FILE_SUFFIX = ".wal"; // The log of a ledger file lives right next to it, with the same name plus this suffix
+constexpr uint32_t MAX_LOG_RECORD_PAYLOAD_LENGTH = 1 << 20; // Far beyond any record ever written (a payment, or an employee with its names), so a longer one means a corrupted header
+
+constexpr size_t DEFAULT_GROUP_COMMIT_RECORDS = 32; // Records that fill a group commit, which then gets synced to disk right away
+constexpr unsigned DEFAULT_GROUP_COMMIT_LATENCY_MS = 10; // The longest a record waits to be synced to disk (0 means each one gets synced before going on)
+constexpr size_t DEFAULT_LOG_COMPACTION_RECORDS = 10000; // Records in the log that trigger folding it into the ledger file (0 means only when quitting)
+
+constexpr size_t CSV_READ_BLOCK_SIZE = 1 << 20; // Bytes read at once from a CSV file being imported
+constexpr size_t MAX_REPORTED_CSV_ERRORS = 100; // Rejected rows reported one by one (the rest just get counted)
+
+constexpr uint64_t DEFAULT_WORKLOAD_SEED = 20240718; // The seed of a synthetic workload, unless it gets a given one
+constexpr size_t WORKLOAD_GENERATION_BLOCK_SIZE = 65536; // Employees or payments drawn by each generation task, from a seed of its own. It never depends on the amount of threads, so neither does the workload
+constexpr uint64_t EMPLOYEES_WORKLOAD_STREAM = 1; // The seeds of the employees' blocks get derived from the workload's seed & this, so they never match the ones of the payments' blocks
+constexpr uint64_t PAYMENTS_WORKLOAD_STREAM = 2;
+constexpr size_t GENERATED_PAY_PERIODS = 104; // Weekly pay dates the generated payments get spread over (2 years of them)
+constexpr double GENERATED_OVERTIME_EXEMPT_SHARE = .10; // Generated employees paid by the overtime-exempt payroll policy
+constexpr double GENERATED_CHURN_SHARE = .10; // Generated employees that get deleted once they got their payments, so they end up as ex employees
+constexpr double GENERATED_OVERTIME_SHARE = .20; // Generated payments with hours beyond MAX_REG_HOURS
+constexpr double GENERATED_MIN_REGULAR_HOURS = 20; // The fewest hours of a generated payment without overtime
+
+constexpr size_t HEADLESS_OUTPUT_BLOCK_SIZE = 1 << 16; // Bytes of results gathered before writing them out at once, in the headless mode
+constexpr size_t TABLE_OUTPUT_BLOCK_SIZE = 1 << 16; // Bytes of a table gathered before writing them out at once
+constexpr size_t EMPLOYEE_ID_TEXT_LENGTH = 36; // The 32 hexadecimal digits of an employee's id, plus its 4 dashes: bdc0a2fb-d39e-4242-9a0a-4e760153f18d
+constexpr int FULL_NAME_TITLE_LENGTH = 10; // "Full Name " (no column of full names in a table gets narrower than its title)
+constexpr size_t ISO_DATE_TEXT_LENGTH = 10; // A date in the ISO 8601 format: 2024-07-18
+constexpr size_t STRING_POOL_BLOCK_SIZE = 1 << 16; // Characters of each block where a StringPool packs its texts (a longer text gets a block of its own)
+constexpr size_t EMPLOYEE_STORAGE_CHUNK_SIZE = 4096; // Employees per chunk of the EmployeeRegistry's storage
+constexpr size_t PAYMENT_STORAGE_CHUNK_SIZE = PARALLEL_REPORT_CHUNK_SIZE; // Payments per chunk of the PaymentColumns, so each chunk of a parallel report is exactly one of them
+constexpr int LATENCY_SUB_BUCKETS_BITS = 2; // Each power of 2 of nanoseconds gets split into 4 latency buckets, so a percentile is at most 25% above the real one
+constexpr size_t LATENCY_BUCKETS_AMOUNT = 64 << LATENCY_SUB_BUCKETS_BITS; // Enough for any latency in nanoseconds that fits in 64 bits
+constexpr size_t FORMATTED_NUMBER_CAPACITY = 512; // Enough characters for any finite double in fixed notation (up to 309 integer digits), with its commas & a short currency symbol
+
+constexpr char ADD_EMPLOYEE_OPTION = 'A';
+constexpr char DELETE_EMPLOYEE_OPTION = 'B';
+constexpr char SHOW_CURRENT_EMPLOYEES_OPTION = 'C';
+constexpr char ADD_PAYMENT_OPTION = 'D';
+constexpr char GENERATE_AND_PRINT_CURRENT_EPR_OPTION = 'E';
+constexpr char SHOW_ALL_THE_PAYMENTS_OPTION = 'F';
+constexpr char GENERATE_AND_PRINT_COMPANY_PR_OPTION = 'G';
+constexpr char GENERATE_AND_PRINT_ALL_EPR_OPTION = 'H';
+constexpr char GENERATE_AND_PRINT_PAY_DATES_PR_OPTION = 'I';
+constexpr char QUITTING_OPTION = 'X';
+
+constexpr size_t DEFAULT_PAYMENTS_PAGE_SIZE = 25; // Payments shown at once by the "all the payments" option (0 means all of them in a single table)
+constexpr char NEXT_PAGE_OPTION = 'N';
+constexpr char PREVIOUS_PAGE_OPTION = 'P';
+constexpr char SEEK_PAYMENT_OPTION = 'S';
+constexpr char FILTER_BY_EMPLOYEE_OPTION = 'E';
+constexpr char ALL_EMPLOYEES_OPTION = 'A';
+constexpr char BACK_TO_MENU_OPTION = 'M';
+
+
+/**
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                         *
+ *             UTILITY FUNCTIONS PROTOTYPES                *
+ *                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ **/
+
+
+// Prints a given value, of almost any kind, once in the terminal
+template<typename T>
+void print(const T &item) {
+    std::cout << item;
+}
+
+// Prints a given value, of almost any kind, N given times in the terminal
+template<typename T>
+void printNTimes(const T &, int);
+
+// Prints a given value, of almost any kind, N given times in the terminal, and then breaks the line
+template<typename T>
+void printNTimesAndBreak(const T &, int);
+
+// Prints a given value, of almost any kind, once in the terminal, and then breaks the line
+template<typename T>
+void printLine(const T &);
+
+// Determines if a given string is a valid floating point number (or integer), like 12, -3.5 or 1.5e3, in a single pass with no allocations
+bool isFloatingPoint(std::string_view);
+
+// Parses a given typed number (an integer or a floating point one, as isFloatingPoint() accepts them) into the reference of a given double.
+// Returns false if it's not such a number, or if it doesn't fit in a double
+bool parseNumber(std::string_view, double &);
+
+// Parses a given integer (an optional sign & just digits) into the reference of a given int. Returns false if it's not such an integer, or if it doesn't fit in an int
+bool parseInteger(std::string_view, int &);
+
+// Receives and validates a double number (or the equivalent of an integer) from the console
+double getDouble(const std::string &, double, double, bool = false, const std::string & = "Invalid input. Please try again.", const std::vector<double> & = {});
+
+// Determines if a given string is a single valid char
+bool containsSingleChar(const std::string &input);
+
+// Receives and validates a char from the console
+char getAlphaChar(const std::string &, const std::string & = "Invalid input. Please try again.");
+
+// Gets a string with or without spaces, from the terminal, as a response of a given question
+std::string getStringFromMessage(const std::string &);
+
+// Formats a given positive int by inserting a comma every 3 digits of its equivalent string, to make it more readable, by US standards
+std::string humanizeUnsignedInteger(unsigned long long int);
+
+// Formats a given positive double by inserting a comma every 3 digits of its equivalent string, to make it more readable, by US standards
+std::string humanizeUnsignedDouble(double, int = 2);
+
+// Formats a given double by inserting a comma every 3 digits of its equivalent string, to make it more readable, and adds a customizable currency symbol
+std::string monetizeDouble(double, int = 2, bool = true, const std::string & = "$");
+
+// Writes a given unsigned integer into a given buffer (from its first to its last character), inserting a comma every 3 digits. Returns where it ended (nullptr if it does not fit)
+char *formatGroupedInteger(char *, char *, unsigned long long int);
+
+// Writes a given double into a given buffer, rounded as a whole to a given amount of decimals, with a comma every 3 digits of its integer part. Returns where it ended (nullptr if it does not fit)
+char *formatGroupedFixed(char *, char *, double, int);
+
+// Writes a given amount of money into a given buffer, grouped & rounded just like formatGroupedFixed(), with a currency symbol before or after it. Returns where it ended (nullptr if it does not fit)
+char *formatMoney(char *, char *, double, int = 2, bool = true, std::string_view = "$");
+
+// Copies the characters of a given number into a given buffer, inserting a comma every 3 digits of its integer part. Returns where it ended (nullptr if it does not fit)
+char *groupIntegerDigits(char *, char *, const char *, const char *);
+
+// Gets the days elapsed since 1970-01-01 until a given year, month & day of the (proleptic) Gregorian calendar (negative for the dates before it)
+int32_t daysFromCivilDate(int, int, int);
+
+// Gets the year, month & day of the (proleptic) Gregorian calendar, into the given references, of a given amount of days elapsed since 1970-01-01
+void civilDateFromDays(int32_t, int &, int &, int &);
+
+// Reads a given date in the ISO 8601 format (YYYY-MM-DD, with a year between 0001 & 9999) into the reference of some given days since 1970-01-01. Returns false if it's not a valid date
+bool parseIsoDate(std::string_view, int32_t &);
+
+// Writes a given date (as days since 1970-01-01) into a given buffer, in the ISO 8601 format (YYYY-MM-DD). Returns where it ended
+char *formatIsoDate(char *, int32_t);
+
+// Formats a given date (as days since 1970-01-01) in the ISO 8601 format (YYYY-MM-DD)
+std::string isoDateToString(int32_t);
+
+// Gets today's (local) date, as days since 1970-01-01
+int32_t getTodaysDate();
+
+// Receives and validates a date in the ISO 8601 format (YYYY-MM-DD) from the console, as days since 1970-01-01
+int32_t getIsoDate(const std::string &);
+
+// Reads the program's options from the command line arguments. Exits the program (showing its usage) if any of them is not valid
+struct ProgramOptions parseProgramOptions(int, char *[]);
+
+
+/**
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                         *
+ *                STRUCTURE DEFINITIONS                    *
+ *                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ **/
+
+
+// An employee's id: a Universally Unique IDentifier (UUID), kept as its 16 bytes instead of its 36 characters, so it gets hashed & compared as 2 integers.
+// It only becomes text (the usual 8-4-4-4-12 hexadecimal digits) to be shown, & it gets read back from text whenever someone types it
+struct EmployeeId {
+    uint64_t high {0}; // The first 16 hexadecimal digits
+    uint64_t low {0}; // The last 16 hexadecimal digits
+
+    bool operator==(const EmployeeId &other) const { return high == other.high && low == other.low; }
+    bool operator!=(const EmployeeId &other) const { return !(*this == other); }
+};
+
+// Hashes an EmployeeId for the unordered containers, mixing both halves (the imported ids don't have to be random at all)
+struct EmployeeIdHash {
+    size_t operator()(const EmployeeId &employeeId) const {
+        uint64_t hash = employeeId.high ^ (employeeId.low * 0x9E3779B97F4A7C15ULL);
+        hash ^= hash >> 33;
+        hash *= 0xFF51AFD7ED558CCDULL;
+        hash ^= hash >> 33;
+        return static_cast<size_t>(hash);
+    }
+};
+
+// A growable array stored in fixed size chunks (CHUNK_SIZE elements each, a power of 2) that never move once allocated: growing only adds a chunk,
+// so its elements keep their addresses & nothing ever gets copied to a bigger buffer (no latency spike when it outgrows its capacity).
+// It only grows & shrinks at its end, & clearing it frees all the chunks at once
+template<typename T, size_t CHUNK_SIZE>
+struct ChunkedVector {
+    static_assert(CHUNK_SIZE > 0 && (CHUNK_SIZE & (CHUNK_SIZE - 1)) == 0, "The chunks' size must be a power of 2");
+
+    // Goes through the elements in order (enough for the range-based for loops & the standard algorithms)
+    struct ConstIterator {
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T *;
+        using reference = const T &;
+
+        const ChunkedVector *chunkedVector {nullptr};
+        size_t position {0};
+
+        const T &operator*() const { return (*chunkedVector)[position]; }
+        const T *operator->() const { return &(*chunkedVector)[position]; }
+        ConstIterator &operator++() { position++; return *this; }
+        ConstIterator operator++(int) { const ConstIterator previous = *this; position++; return previous; }
+        bool operator==(const ConstIterator &other) const { return position == other.position; }
+        bool operator!=(const ConstIterator &other) const { return position != other.position; }
+    };
+
+    void push_back(T); // Adds an element at the end, allocating a new chunk only when the last one is full
+    void append(const T *, size_t); // Adds a given run of elements at the end, copying them a whole chunk at a time
+    void pop_back() { back() = T {}; elementsAmount--; } // The removed element gets reset, so it does not hold on to its resources (its chunk gets kept)
+    void clear() { chunks.clear(); elementsAmount = 0; } // Frees all the chunks at once
+
+    [[nodiscard]] T &operator[](const size_t position) { return chunks[position / CHUNK_SIZE][position % CHUNK_SIZE]; }
+    [[nodiscard]] const T &operator[](const size_t position) const { return chunks[position / CHUNK_SIZE][position % CHUNK_SIZE]; }
+    [[nodiscard]] T &back() { return (*this)[elementsAmount - 1]; }
+    [[nodiscard]] bool empty() const { return elementsAmount == 0; }
+    [[nodiscard]] size_t size() const { return elementsAmount; }
+    [[nodiscard]] ConstIterator begin() const { return ConstIterator {this, 0}; }
+    [[nodiscard]] ConstIterator end() const { return ConstIterator {this, elementsAmount}; }
+
+    // The chunks themselves, for whoever needs contiguous runs of elements (every chunk is full, but the last one)
+    [[nodiscard]] size_t chunksAmount() const { return (elementsAmount + CHUNK_SIZE - 1) / CHUNK_SIZE; }
+    [[nodiscard]] const T *chunkData(const size_t chunk) const { return chunks[chunk].get(); }
+    [[nodiscard]] size_t chunkSize(const size_t chunk) const { return std::min(CHUNK_SIZE, elementsAmount - chunk * CHUNK_SIZE); }
+
+private:
+    std::vector<std::unique_ptr<T[]>> chunks;
+    size_t elementsAmount {0};
+};
+
+// The payroll policies: each one is a set of payroll rules (the overtime threshold & multiplier, plus the deductions) that an employee gets paid by
+enum PayrollPolicy : uint8_t {
+    STANDARD_PAYROLL_POLICY = 0, // The hours beyond 40 in the week are overtime, paid 1.5 times the regular rate
+    OVERTIME_EXEMPT_PAYROLL_POLICY = 1 // Every hour worked is a regular one (salaried-like employees, with no overtime at all)
+};
+
+constexpr int PAYROLL_POLICIES_AMOUNT = 2;
+
+// The rules behind a payroll policy. The ones of the PAYROLL_RULES table are compile time constants, so the calculations specialised for a policy
+// get them folded right into their code (no lookups, nor branches on the policy, per payment)
+struct PayrollRules {
+    std::string_view name; // As it gets typed & shown
+    double maxRegHours; // The hours worked in the week beyond which they are overtime
+    double otMultiplier; // The overtime rate, as a multiple of the regular rate
+    double ficaRate;
+    double ssMedRate;
+};
+
+// The rules of each payroll policy, by its value
+constexpr PayrollRules PAYROLL_RULES[PAYROLL_POLICIES_AMOUNT] = {
+    {.name = "standard", .maxRegHours = MAX_REG_HOURS, .otMultiplier = OT_MULT, .ficaRate = FICA_RATE, .ssMedRate = SS_MED_RATE},
+    {.name = "overtime-exempt", .maxRegHours = MAX_HOURS_WORKED, .otMultiplier = OT_MULT, .ficaRate = FICA_RATE, .ssMedRate = SS_MED_RATE} // Nobody works beyond MAX_HOURS_WORKED
+};
+
+struct Employee {
+    EmployeeId id;
+    std::string firstName;
+    std::string lastName;
+    double regRate {0.0};
+    PayrollPolicy payrollPolicy {STANDARD_PAYROLL_POLICY}; // The rules its payments follow
+
+    // Employee() = default;
+
+    [[nodiscard]] std::string fullName() const { return firstName + " " + lastName; }
+    [[nodiscard]] size_t fullNameLength() const { return firstName.size() + 1 + lastName.size(); }
+};
+
+// Owns the current Employee structure variables, plus a hash index from each employee's id to its position inside their storage,
+// so the lookups by id stop being linear scans comparing ids. The deletion is tombstone-free: the last employee
+// gets moved into the hole (swap-and-pop) and only its own index entry needs to be fixed afterwards
+struct EmployeeRegistry {
+    ChunkedVector<Employee, EMPLOYEE_STORAGE_CHUNK_SIZE> employees; // Our current employees, in no particular order (a deletion moves the last one into the deleted position)
+    std::unordered_map<EmployeeId, size_t, EmployeeIdHash> positionsById; // Position of each employee inside the storage, by its id
+
+    [[nodiscard]] bool empty() const { return employees.empty(); }
+    [[nodiscard]] size_t size() const { return employees.size(); }
+};
+
+// An amount of money, kept as a whole number of cents, so adding amounts up is exact (& the same in any order, unlike with doubles).
+// A computed double only becomes Money by getting rounded to the nearest cent (ties to even), & it only goes back to dollars to be shown.
+// It's exact for any amount within 2^51 cents (over 22 trillion dollars)
+struct Money {
+    int64_t cents {0};
+
+    // Rounds a given amount of cents to the nearest whole one (ties to even), just like the AVX2 kernels do. An amount beyond MAX_ROUNDED_CENTS saturates to it first,
+    // with the very same comparisons as the AVX2 max & min instructions (so NaN becomes -MAX_ROUNDED_CENTS in both)
+    [[nodiscard]] static Money fromCents(const double cents) {
+        const double lowerBoundedCents = cents > -MAX_ROUNDED_CENTS ? cents : -MAX_ROUNDED_CENTS;
+        return Money {std::llrint(lowerBoundedCents < MAX_ROUNDED_CENTS ? lowerBoundedCents : MAX_ROUNDED_CENTS)};
+    }
+    [[nodiscard]] static Money fromDollars(const double dollars) { return fromCents(dollars * 100.0); }
+    [[nodiscard]] Money times(const double rate) const { return fromCents(static_cast<double>(cents) * rate); } // A given rate of it (like a deduction), rounded to the cent
+    [[nodiscard]] double dollars() const { return static_cast<double>(cents) / 100.0; }
+
+    Money &operator+=(const Money other) { cents += other.cents; return *this; }
+    Money &operator-=(const Money other) { cents -= other.cents; return *this; }
+    Money operator+(const Money other) const { return Money {cents + other.cents}; }
+    Money operator-(const Money other) const { return Money {cents - other.cents}; }
+    bool operator==(const Money other) const { return cents == other.cents; }
+    bool operator!=(const Money other) const { return cents != other.cents; }
+    bool operator<(const Money other) const { return cents < other.cents; }
+    bool operator>(const Money other) const { return cents > other.cents; }
+};
+
+// The Employee could be deleted from the system, but we still have its data (I'm not using an Employee,
+// to avoid theorically a DB persistence validation over the data layer [obviously none-existent, as we are not even using a DB in the first place])
+// But still in a real life scenario it would the best approach to avoid many issues, using an instance/object of a Class instead of structure variables
+// ...and we just need a few fields anyway, so it will remain denormalized with these 3 elements, instead of using an Employee structure variable.
+// The names are only views (of the employee's own strings, or of the ones interned by the PaymentColumns' dictionary), so a Payment never copies them
+struct Payment {
+    EmployeeId employeeId;
+    std::string_view firstName;
+    std::string_view lastName;
+
+    double hoursWorked {0.0};
+    double regRate {0.0};
+    int32_t payDate {0}; // The date of the pay period the payment belongs to, as days since 1970-01-01
+    PayrollPolicy payrollPolicy {STANDARD_PAYROLL_POLICY}; // The rules it follows (the ones of its employee when it got made)
+
+    // Payment() = default; // Prevents from using the cleaner designated list initializer syntax in MSVS
+
+    [[nodiscard]] const PayrollRules &rules() const { return PAYROLL_RULES[payrollPolicy]; }
+    [[nodiscard]] double regHours() const { return (hoursWorked <= rules().maxRegHours ? hoursWorked : rules().maxRegHours); }
+    [[nodiscard]] double otHours() const { return (hoursWorked <= rules().maxRegHours ? 0 : hoursWorked - rules().maxRegHours); }
+    [[nodiscard]] double otRate() const { return regRate * rules().otMultiplier; }
+    // Each pay gets rounded to the cent on its own, & each deduction too (as a rate of the already rounded total pay), so the rest is exact
+    [[nodiscard]] Money regPay() const { return Money::fromDollars(regHours() * regRate); }
+    [[nodiscard]] Money otPay() const { return Money::fromDollars(otHours() * otRate()); }
+    [[nodiscard]] Money totalPay() const { return regPay() + otPay(); }
+    [[nodiscard]] Money fica() const { return totalPay().times(rules().ficaRate); }
+    [[nodiscard]] Money socSec() const { return totalPay().times(rules().ssMedRate); }
+    [[nodiscard]] Money totDeductions() const { return fica() + socSec(); }
+    [[nodiscard]] Money netPay() const { return totalPay() - totDeductions(); }
+};
+
+// The derived figures of a single Payment structure variable, computed only once each (instead of every member function calling the previous ones again),
+// but still with exactly the same operations as the Payment's member functions, so the results are identical
+struct PaymentFigures {
+    double regHours {0.0};
+    double otHours {0.0};
+    Money regPay;
+    Money otPay;
+    Money fica;
+    Money socSec;
+};
+
+// The per-lane accumulators of the aggregation kernels: the hours as doubles, & the money as whole cents (so it adds up exactly, in any order)
+struct KernelLanes {
+    double hours[KERNEL_HOURS_FIELDS][KERNEL_LANES] {};
+    int64_t cents[KERNEL_MONEY_FIELDS][KERNEL_LANES] {};
+};
+
+struct PayrollReport {
+    int paymentsAmount {0};
+    double regHours {0.0};
+    double otHours {0.0};
+    Money regPay;
+    Money otPay;
+    Money fica;
+    Money socSec;
+
+    // PayrollReport() = default;
+
+    [[nodiscard]] Money totalPay() const { return regPay + otPay; }
+    [[nodiscard]] Money totDeductions() const { return fica + socSec; }
+    [[nodiscard]] Money netPay() const { return totalPay() - totDeductions(); }
+};
+
+// Logical Interpretation: An EmployeePayrollReport is a PayrollReport, plus adding an employee's id
+struct EmployeePayrollReport : PayrollReport {
+    // The Employee could be deleted from the system, but we still have its data (I'm not using an Employee,
+    // to avoid theorically a DB persistence validation over the data layer [obviously none-existent, as we are not even using a DB in the first place])
+    // But still in a real life scenario it would the best approach to avoid many issues, using an instance/object of a Class instead of structure variables
+    // ...and we just need a few fields anyway, so it will remain denormalized with these 2 (its full name is a view of the one interned by the PaymentColumns' dictionary)
+    EmployeeId employeeId;
+    std::string_view employeeFullName; // "First Last", interned as a single text
+
+    // EmployeePayrollReport() = default;
+
+    [[nodiscard]] std::string_view fullName() const { return employeeFullName; }
+};
+
+// Both, the addition & average reports of a group of payments, built together in a single pass over them. Optionally (as it costs a bit more per payment),
+// it also has the minimum, the maximum & the (population) standard deviation of each field among those same payments
+template<typename Report>
+struct PayrollReportSummary {
+    Report addition;
+    Report average;
+
+    bool hasDispersion {false}; // If the next three reports were computed at all
+    PayrollReport minimum;
+    PayrollReport maximum;
+    PayrollReport standardDeviation;
+};
+
+// A what-if scenario: the payroll rules that each payroll policy would follow, to simulate what the PayrollReports of the very same payments would become
+struct PayrollScenario {
+    std::string name;
+    PayrollRules rulesByPolicy[PAYROLL_POLICIES_AMOUNT];
+};
+
+
+using StringHandle = uint32_t; // Identifies a text interned by a StringPool
+
+// Interns texts: each distinct text gets stored only once, packed one after the other inside big blocks of characters, & gets identified by a compact handle.
+// The blocks never move (not even when the StringPool itself gets moved), so the views of its texts stay valid for as long as it lives
+struct StringPool {
+    StringPool() = default;
+    StringPool(const StringPool &) = delete;
+    StringPool &operator=(const StringPool &) = delete;
+    StringPool(StringPool &&) = default;
+    StringPool &operator=(StringPool &&) = default;
+
+    StringHandle intern(std::string_view); // The handle of the given text, storing it first if it was not stored yet
+
+    [[nodiscard]] std::string_view view(const StringHandle handle) const { return texts[handle]; }
+    [[nodiscard]] size_t size() const { return texts.size(); }
+
+private:
+    std::vector<std::unique_ptr<char[]>> blocks;
+    char *lastBlockFreeSpace {nullptr}; // Where the next text goes, inside the last block
+    size_t lastBlockFreeBytes {0};
+    std::vector<std::string_view> texts; // The texts themselves, by handle
+    std::unordered_map<std::string_view, StringHandle> handlesByText;
+};
+
+// Columnar (structure of arrays) storage of the payments: only the numeric data the aggregations need, each field contiguous in memory,
+// so a whole aggregation pass streams 16 bytes per payment instead of dragging the three strings of every Payment through the cache.
+// The employee column is dictionary-encoded: each payment stores a small code, & the employee's id & names are stored only once per code.
+// A Payment structure variable gets rebuilt from its position only when it's needed as a whole (to print it, for instance).
+// The columns are chunked, so inserting a payment never relocates the ones already stored
+struct PaymentColumns {
+    ChunkedVector<double, PAYMENT_STORAGE_CHUNK_SIZE> hoursWorked;
+    ChunkedVector<double, PAYMENT_STORAGE_CHUNK_SIZE> regRates;
+    ChunkedVector<uint32_t, PAYMENT_STORAGE_CHUNK_SIZE> employeeCodes; // Code of the employee to whom each payment belongs (its position inside employeeIds)
+    ChunkedVector<int32_t, PAYMENT_STORAGE_CHUNK_SIZE> payDates; // The pay date of each payment, as days since 1970-01-01
+    ChunkedVector<PayrollPolicy, PAYMENT_STORAGE_CHUNK_SIZE> payrollPolicies; // The payroll policy that each payment follows
+    size_t paymentsAmountsByPolicy[PAYROLL_POLICIES_AMOUNT] {}; // How many payments follow each payroll policy
+
+    StringPool employeeNames; // The full names of the dictionary below, each distinct one stored only once (many employees share the same name)
+    std::vector<EmployeeId> employeeIds; // The dictionary itself: the employee's id of each code
+    std::vector<StringHandle> employeeFullNames; // Also the names of each code (as "First Last"), so even the ex employees can be reported by name
+    std::vector<uint32_t> employeeFirstNameLengths; // Where the first name ends inside each full name
+    std::unordered_map<EmployeeId, uint32_t, EmployeeIdHash> employeeCodesById; // The reverse dictionary: the code of each employee's id
+    size_t largestFullNameLength {0}; // Kept up to date along with the dictionary, so the tables never have to look for it
+
+    [[nodiscard]] size_t size() const { return hoursWorked.size(); }
+    // If the payments do not all follow the same payroll policy (so the aggregation kernels have to mask out the other policies' payments)
+    [[nodiscard]] bool hasMixedPayrollPolicies() const { return std::count_if(std::begin(paymentsAmountsByPolicy), std::end(paymentsAmountsByPolicy), [](const size_t amount) { return amount > 0; }) > 1; }
+};
+
+// The payments partitioned by their pay dates: the addition PayrollReport of each distinct pay date, in ascending order, with a segment tree over them
+// (every node is the merge of its two children), so the report of any range of pay dates gets answered in logarithmic time, without visiting a single payment.
+// Each node only depends on the pay dates' additions, so a range always gets the very same report, no matter the order in which the tree got updated
+struct PayDateIndex {
+    std::vector<int32_t> payDates; // The distinct pay dates of the payments, in ascending order
+    std::vector<PayrollReport> additionsByPayDate; // The addition of the payments of each pay date above, accumulated in the order they were made
+    std::vector<PayrollReport> tree; // Node 1 is the root, the children of the node i are 2i & 2i + 1, & the leaves (one per pay date) start at the node leavesCapacity
+    size_t leavesCapacity {0}; // A power of 2, at least the amount of pay dates (the tree only gets rebuilt when it runs out of leaves, or a pay date goes in the middle)
+};
+
+// Owns all the payments performed by the company (even to ex employees), plus a secondary index with the positions
+// of the payments that belong to each employee's id, so the per-employee reports only visit that employee's own payments.
+// It also keeps the company's addition PayrollReport running, updated on every inserted payment, so it never has to be rebuilt from scratch,
+// & the addition of every pay date, so the reports of a range of them (a quarter, the year to date...) don't have to scan the payments either
+struct PaymentLedger {
+    PaymentColumns columns; // All the payments performed by the company to the employees, in the order they were made, stored by columns
+    std::unordered_map<EmployeeId, std::vector<size_t>, EmployeeIdHash> paymentPositionsByEmployeeId; // Positions inside the columns, for each employee's id
+    PayrollReport companyAdditionPayrollReport; // The addition of all the payments above, accumulated in the very same order
+    PayDateIndex payDateIndex; // The addition of the payments of each pay date
+
+    [[nodiscard]] bool empty() const { return columns.size() == 0; }
+    [[nodiscard]] size_t size() const { return columns.size(); }
+};
+
+// A position among the payments of a PaymentLedger (all of them, or only those of one employee), to go through them a page at a time.
+// The payments get numbered from 0, in the order they were made. It's only valid while no payment gets inserted into its PaymentLedger
+struct PaymentCursor {
+    const PaymentLedger *paymentLedger {nullptr};
+    const std::vector<size_t> *employeePaymentPositions {nullptr}; // The positions of the filtered employee's payments (nullptr means no filter)
+    EmployeeId employeeId; // The id of the filtered employee (if any)
+    size_t pageSize {0}; // 0 means all the payments in a single page
+    size_t offset {0}; // The number of the next payment to be shown
+
+    [[nodiscard]] bool isFiltered() const { return employeePaymentPositions != nullptr; }
+    [[nodiscard]] size_t size() const { return employeePaymentPositions ? employeePaymentPositions->size() : paymentLedger->size(); }
+    [[nodiscard]] bool atEnd() const { return offset >= size(); }
+    [[nodiscard]] size_t positionOf(const size_t number) const { return employeePaymentPositions ? (*employeePaymentPositions)[number] : number; }
+};
+
+
+// A fixed set of threads that run together the indexed tasks of one job at a time (fork-join style). The calling thread takes tasks too,
+// so a ThreadPool of N workers only starts N - 1 threads, & one of a single worker just runs everything sequentially
+struct ThreadPool {
+    explicit ThreadPool(unsigned);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    [[nodiscard]] unsigned workersAmount() const { return static_cast<unsigned>(threads.size()) + 1; }
+
+    // Runs the given task once for every index from 0 to the given amount (excluded), & returns only when all of them have finished
+    void runTasks(size_t, const std::function<void(size_t)> &);
+
+private:
+    size_t takeTasks(); // Runs tasks of the current job, until there are no more left. Returns how many it ran
+    void workerLoop(); // What each one of the started threads does, until the pool gets destroyed
+
+    std::vector<std::thread> threads;
+    std::mutex jobMutex;
+    std::condition_variable jobStarted;
+    std::condition_variable jobFinished;
+    const std::function<void(size_t)> *currentTask {nullptr};
+    size_t tasksAmount {0};
+    std::atomic<size_t> nextTaskIndex {0};
+    size_t finishedTasksAmount {0};
+    unsigned busyThreads {0}; // Threads still inside the current job. A job only ends once all of them have left it, so none can wander into the next one
+    unsigned long long jobNumber {0}; // Increased on every job, so the threads can tell a new job from the one they just finished
+    bool stopping {false};
+};
+
+#ifdef PAYROLL_INSTRUMENTATION
+// The operations timed by the instrumentation: every menu branch, report builder & printer, plus the I/O that may take long
+enum InstrumentedOperation : uint8_t {
+    ADD_EMPLOYEE_OPERATION,
+    DELETE_EMPLOYEE_OPERATION,
+    SHOW_CURRENT_EMPLOYEES_OPERATION,
+    ADD_PAYMENT_OPERATION,
+    SHOW_ALL_THE_PAYMENTS_OPERATION,
+    CURRENT_EPR_OPERATION,
+    COMPANY_PR_OPERATION,
+    ALL_EPR_OPERATION,
+    PAY_DATES_PR_OPERATION,
+    CREATE_ADDITION_PR_IN_PARALLEL_OPERATION,
+    CREATE_LEDGER_FILE_ADDITION_PR_OPERATION,
+    CREATE_PAY_DATES_ADDITION_PR_OPERATION,
+    CREATE_ADDITION_EPR_IN_PARALLEL_OPERATION,
+    CREATE_CURRENT_EPR_SUMMARY_OPERATION,
+    CREATE_ALL_EPR_SUMMARIES_OPERATION,
+    CREATE_AVERAGE_PR_OPERATION,
+    CREATE_PAY_DATE_INDEX_OPERATION,
+    PRINT_COMPANY_PR_OPERATION,
+    PRINT_PAY_DATES_PR_OPERATION,
+    PRINT_EPR_OPERATION,
+    PRINT_ALL_EPR_OPERATION,
+    PRINT_PAYMENTS_PAGE_OPERATION,
+    PRINT_EMPLOYEES_TABLE_OPERATION,
+    PRINT_SCENARIO_COMPARISON_OPERATION,
+    SIMULATE_SCENARIOS_OPERATION,
+    IMPORT_EMPLOYEES_CSV_OPERATION,
+    IMPORT_PAYMENTS_CSV_OPERATION,
+    GENERATE_SYNTHETIC_WORKLOAD_OPERATION,
+    LOAD_LEDGER_FILE_OPERATION,
+    REPLAY_WRITE_AHEAD_LOG_OPERATION,
+    SYNC_WRITE_AHEAD_LOG_OPERATION,
+    COMPACT_WRITE_AHEAD_LOG_OPERATION,
+    RUN_HEADLESS_COMMAND_OPERATION,
+    INSTRUMENTED_OPERATIONS_AMOUNT
+};
+
+// The name of each InstrumentedOperation: the function it times
+constexpr std::string_view INSTRUMENTED_OPERATION_NAMES[INSTRUMENTED_OPERATIONS_AMOUNT] = {
+    "addEmployee", "deleteCurrentEmployee", "showCurrentEmployeesTable", "addPayment", "printAllThePayments", "generateAndPrintCurrentEmployeePayrollReports",
+    "generateAndPrintCompanyPayrollReports", "generateAndPrintAllEmployeesPayrollReports", "generateAndPrintPayDatesPayrollReports",
+    "createAdditionPayrollReportInParallel", "createAdditionPayrollReport(ledgerFile)", "createAdditionPayrollReportOfPayDates",
+    "createAdditionEmployeePayrollReportInParallel", "createCurrentEmployeePayrollReportSummary", "createAllEmployeesPayrollReportSummaries",
+    "createAveragePayrollReportFromAddition", "createPayDateIndex", "printCompanyPayrollReports", "printPayDatesPayrollReports", "printEmployeePayrollReports",
+    "printAllEmployeesPayrollReports", "printPaymentsPage", "showEmployeesTable", "printPayrollScenarioComparisonTable", "simulatePayrollScenarios",
+    "importEmployeesCsv", "importPaymentsCsv", "generateSyntheticWorkload", "loadLedgerFile", "replayWriteAheadLog", "WriteAheadLog::writeAndSync", "compactWriteAheadLog", "runHeadlessCommand"
+};
+
+// The events counted by the instrumentation
+enum InstrumentedCounter : uint8_t {
+    EMPLOYEES_INSERTED_COUNTER,
+    PAYMENTS_INSERTED_COUNTER,
+    LOG_RECORDS_APPENDED_COUNTER,
+    CSV_ROWS_READ_COUNTER,
+    PAYMENTS_AGGREGATED_COUNTER,
+    PAYMENT_SCENARIOS_SIMULATED_COUNTER,
+    INSTRUMENTED_COUNTERS_AMOUNT
+};
+
+// The name of each InstrumentedCounter
+constexpr std::string_view INSTRUMENTED_COUNTER_NAMES[INSTRUMENTED_COUNTERS_AMOUNT] = {
+    "employeesInserted", "paymentsInserted", "logRecordsAppended", "csvRowsRead", "paymentsAggregated", "paymentScenariosSimulated"
+};
+
+// The statistics of an InstrumentedOperation, updated by any thread without locking. The allocations are the ones made by the calling thread
+// while inside the operation, & (just like the time) they include the ones of any operation nested in it
+struct OperationStats {
+    std::atomic<uint64_t> calls {0};
+    std::atomic<uint64_t> totalNanoseconds {0};
+    std::atomic<uint64_t> maxNanoseconds {0};
+    std::atomic<uint64_t> allocations {0};
+    std::atomic<uint64_t> allocatedBytes {0};
+    std::atomic<uint64_t> latencyBuckets[LATENCY_BUCKETS_AMOUNT] {}; // How many calls took each range of nanoseconds (see getLatencyBucket())
+};
+
+// Everything gathered by the instrumentation along the whole run
+struct InstrumentationStats {
+    OperationStats operations[INSTRUMENTED_OPERATIONS_AMOUNT];
+    std::atomic<uint64_t> counters[INSTRUMENTED_COUNTERS_AMOUNT] {};
+};
+
+// Times its own scope as one call of a given InstrumentedOperation, counting meanwhile the allocations of the calling thread (see PAYROLL_TIME_OPERATION)
+struct ScopedOperationTimer {
+    explicit ScopedOperationTimer(InstrumentedOperation);
+    ~ScopedOperationTimer();
+    ScopedOperationTimer(const ScopedOperationTimer &) = delete;
+    ScopedOperationTimer &operator=(const ScopedOperationTimer &) = delete;
+
+private:
+    InstrumentedOperation operation;
+    uint64_t firstAllocations;
+    uint64_t firstAllocatedBytes;
+    std::chrono::steady_clock::time_point startTime;
+};
+
+// Prints the instrumentation's statistics once it goes out of scope (at the end of the program), & writes them as JSON too if it has a path for that
+struct InstrumentationReportOnExit {
+    std::string jsonPath;
+
+    ~InstrumentationReportOnExit();
+};
+
+// The only mutable globals of the program: the instrumentation gets fed from everywhere (even from the global operator new), so it can't be passed around
+inline InstrumentationStats instrumentationStats;
+inline thread_local uint64_t threadAllocations = 0; // Made by the current thread so far
+inline thread_local uint64_t threadAllocatedBytes = 0;
+#endif
+
+// The possible orders of the batch of EmployeePayrollReports of every employee (always from the largest to the smallest)
+enum EmployeeReportsOrder {
+    BY_NET_PAY,
+    BY_TOTAL_HOURS
+};
+
+// A string stored inside the string table of a ledger file: where it starts (from the beginning of the table) & how many bytes it has
+struct LedgerFileString {
+    uint64_t offset;
+    uint64_t length;
+};
+
+// A current Employee, as stored inside a ledger file (fixed width, its names live in the string table)
+struct LedgerFileEmployee {
+    EmployeeId id;
+    LedgerFileString firstName;
+    LedgerFileString lastName;
+    double regRate;
+    PayrollPolicy payrollPolicy;
+    uint8_t reserved[7]; // Always zeros (the record stays a multiple of 8 bytes, with no uninitialized padding)
+};
+
+// An entry of the payments' employee dictionary (one per code, even for the ex employees), as stored inside a ledger file
+struct LedgerFileDictionaryEntry {
+    EmployeeId id;
+    LedgerFileString firstName;
+    LedgerFileString lastName;
+};
+
+// The very beginning of a ledger file. The file is a snapshot of the whole system: the current employees, the payments' employee dictionary,
+// the payment columns (exactly as they are kept in memory) & a string table. Every section starts at an offset multiple of 8, so once the
+// file gets mapped into memory, each section can be used in place as a plain array, with no parsing at all (the numbers are in the machine's own byte order)
+struct LedgerFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    uint64_t employeesAmount;
+    uint64_t dictionaryEntriesAmount;
+    uint64_t paymentsAmount;
+    uint64_t employeesOffset; // LedgerFileEmployee[employeesAmount]
+    uint64_t dictionaryOffset; // LedgerFileDictionaryEntry[dictionaryEntriesAmount]
+    uint64_t hoursWorkedOffset; // double[paymentsAmount]
+    uint64_t regRatesOffset; // double[paymentsAmount]
+    uint64_t employeeCodesOffset; // uint32_t[paymentsAmount]
+    uint64_t payDatesOffset; // int32_t[paymentsAmount]
+    uint64_t payrollPoliciesOffset; // PayrollPolicy[paymentsAmount]
+    uint64_t stringTableOffset; // char[stringTableSize]
+    uint64_t stringTableSize;
+    uint64_t lastLogSequenceNumber; // The last record of the write-ahead log already folded into this snapshot (the older ones must not be replayed again)
+    uint64_t paymentsAmountsByPolicy[PAYROLL_POLICIES_AMOUNT]; // How many payments follow each payroll policy (so the reports straight from the file know if they are mixed)
+
+    // The company's running addition PayrollReport, so it's available right away, without traversing the payments
+    int64_t reportPaymentsAmount;
+    double reportRegHours;
+    double reportOtHours;
+    int64_t reportRegPayCents;
+    int64_t reportOtPayCents;
+    int64_t reportFicaCents;
+    int64_t reportSocSecCents;
+};
+
+// The outcome of opening a ledger file
+enum LedgerFileOpening {
+    LEDGER_FILE_MISSING, // There is nothing saved yet (not an error)
+    LEDGER_FILE_OPENED,
+    LEDGER_FILE_UNUSABLE // It exists, but it could not be read or it's not valid, so it must be left untouched (never saved over)
+};
+
+// A ledger file opened in memory (mapped, if possible), with its sections ready to be used in place. It gets unmapped when destroyed
+struct MappedLedgerFile {
+    MappedLedgerFile() = default;
+    ~MappedLedgerFile();
+    MappedLedgerFile(const MappedLedgerFile &) = delete;
+    MappedLedgerFile &operator=(const MappedLedgerFile &) = delete;
+
+    const char *bytes {nullptr}; // The whole file
+    size_t size {0};
+    bool isMapped {false}; // If the bytes are mapped from the file (or just read into the fallback buffer instead)
+    std::vector<char> fallbackBuffer;
+
+    const LedgerFileHeader *header {nullptr};
+    const LedgerFileEmployee *employees {nullptr};
+    const LedgerFileDictionaryEntry *dictionary {nullptr};
+    const double *hoursWorked {nullptr};
+    const double *regRates {nullptr};
+    const uint32_t *employeeCodes {nullptr};
+    const int32_t *payDates {nullptr};
+    const PayrollPolicy *payrollPolicies {nullptr};
+    const char *stringTable {nullptr};
+
+    PayrollReport payrollReport; // The company's running addition PayrollReport: the one saved in the header, or the one rebuilt from the payments (for a version 5 file)
+};
+
+// The shape of a synthetic workload: how many employees & payments get generated, & from which seed (the same seed, over the same loaded data, always generates the very same workload)
+struct SyntheticWorkload {
+    size_t employeesAmount {0};
+    size_t paymentsAmount {0}; // Only generated if there is at least one employee to receive them
+    uint64_t seed {DEFAULT_WORKLOAD_SEED};
+    double overtimeExemptShare {GENERATED_OVERTIME_EXEMPT_SHARE};
+    double churnShare {GENERATED_CHURN_SHARE};
+};
+
+// The outcome of generating a SyntheticWorkload
+struct WorkloadGenerationReport {
+    uint64_t seed {0};
+    size_t generatedEmployees {0};
+    size_t deletedEmployees {0}; // Among the generated ones (the churn)
+    size_t generatedPayments {0};
+    double seconds {0.0};
+};
+
+// The options received by the program through the command line
+struct ProgramOptions {
+    unsigned reportWorkers {1}; // Threads used to build the reports that still have to traverse payments. 1 runs the very same chunks, just one after another
+    std::string ledgerFilePath {DEFAULT_LEDGER_FILE_PATH}; // Where the whole system gets loaded from at the start, & saved to at the end
+    bool onlyPrintLedgerReport {false}; // If we must just print the company's PayrollReports of the ledger file (straight from it), & exit
+    size_t groupCommitRecords {DEFAULT_GROUP_COMMIT_RECORDS};
+    unsigned groupCommitLatencyMs {DEFAULT_GROUP_COMMIT_LATENCY_MS};
+    size_t logCompactionRecords {DEFAULT_LOG_COMPACTION_RECORDS};
+    std::string employeesCsvPath; // Employees to import (without any menu), if not empty
+    std::string paymentsCsvPath; // Payments to import (without any menu), if not empty
+    std::string scenariosCsvPath; // What-if scenarios to simulate over all the payments (without any menu), if not empty
+    std::string instrumentationJsonPath; // Where the instrumentation's statistics get written as JSON when the program ends, if not empty (only with PAYROLL_INSTRUMENTATION)
+    SyntheticWorkload syntheticWorkload; // Generated (without any menu), if it has any employees
+
+    size_t paymentsPageSize {DEFAULT_PAYMENTS_PAGE_SIZE};
+
+    bool isHeadless {false}; // If the commands come from the standard input, one per line (with no menu at all), & the results go out as JSON lines
+
+    [[nodiscard]] bool isImporting() const { return !employeesCsvPath.empty() || !paymentsCsvPath.empty(); }
+    [[nodiscard]] bool isGenerating() const { return syntheticWorkload.employeesAmount > 0; }
+};
+
+// The outcome of importing a CSV file
+struct CsvImportReport {
+    std::string path;
+    size_t importedRows {0};
+    size_t rejectedRows {0};
+    double seconds {0.0};
+};
+
+// Renders the tables into a reusable buffer, cell by cell, instead of sending each cell through the stream (& flushing on every line), & writes
+// the buffer out by blocks. The numbers follow the stream's own floating point format (fixed or not, & its precision), so the tables look just as
+// they did when printed straight through it
+struct TableRenderer {
+    explicit TableRenderer(std::ostream &);
+    ~TableRenderer();
+    TableRenderer(const TableRenderer &) = delete;
+    TableRenderer &operator=(const TableRenderer &) = delete;
+
+    void appendText(std::string_view); // As it is
+    void appendPadding(int); // The given amount of blanks (none, if it's negative)
+    void appendNumber(double, int); // Right aligned to the given width, like setw()
+    void appendInteger(unsigned long long, int); // Right aligned to the given width, like setw()
+    void appendMoney(double, int); // Monetized (through the same formatting engine as monetizeDouble()), right aligned to the given width
+    void appendEmployeeId(const EmployeeId &); // As text
+    void appendIsoDate(int32_t); // A date (as days since 1970-01-01), in the ISO 8601 format
+    void endLine(); // Breaks the line, writing out the buffer once it has gathered a whole block
+    void flush(); // Writes out the buffer right now
+
+private:
+    std::ostream &output;
+    std::string buffer;
+    std::chars_format numbersFormat;
+    int numbersPrecision;
+};
+
+// The kinds of changes recorded in the write-ahead log
+enum LogRecordType : uint32_t {
+    EMPLOYEE_ADDED = 1,
+    EMPLOYEE_DELETED = 2,
+    PAYMENT_ADDED = 3
+};
+
+// The fixed beginning of every record in the write-ahead log, right before its payload. The checksum covers this header (with the checksum set to 0) & the payload,
+// so a record torn by a crash, or corrupted afterwards, gets detected when replaying
+struct LogRecordHeader {
+    uint32_t payloadLength;
+    uint32_t checksum; // CRC-32
+    uint64_t sequenceNumber; // Increased on every record, & never reset (not even when the log gets compacted)
+    uint32_t type; // A LogRecordType
+    uint32_t reserved;
+};
+
+// An append-only log where every change gets recorded before going on, so no change is lost between two snapshots of the ledger file.
+// The records get synced to disk in groups (group commit) by a background flusher: as soon as a group gets full, or its first record has waited the
+// given latency, whichever happens first. With a latency of 0 there is no flusher at all, & each record gets synced to disk right when appended
+struct WriteAheadLog {
+    WriteAheadLog(const std::string &, size_t, unsigned);
+    ~WriteAheadLog();
+    WriteAheadLog(const WriteAheadLog &) = delete;
+    WriteAheadLog &operator=(const WriteAheadLog &) = delete;
+
+    [[nodiscard]] bool isOpen() const { return file != nullptr; }
+
+    // Appends a record of the given type & payload, with the next sequence number. It may get synced to disk a bit later (see above)
+    void append(LogRecordType, const std::string &);
+
+    // Syncs to disk right now all the records appended so far
+    void flush();
+
+    // Flushes & empties the log (once all its records are safely folded into a snapshot)
+    void truncate();
+
+    uint64_t nextSequenceNumber {1};
+    size_t recordsAmount {0}; // Records currently in the log (since it was last emptied)
+    size_t syncsAmount {0}; // Times the log has been synced to disk (fewer than the records, thanks to the group commits)
+
+private:
+    void flusherLoop(); // What the background flusher does, until the log gets destroyed
+    void writeAndSync(const std::string &); // Writes the given bytes at the end of the log file, & syncs it to disk
+
+    std::string path;
+    FILE *file {nullptr};
+    size_t groupCommitRecords;
+    std::chrono::milliseconds groupCommitLatency;
+    std::thread flusher;
+    std::mutex pendingMutex; // Guards the records still pending to be written (& the stopping flag)
+    std::mutex fileMutex; // Guards the file itself, so the flusher & the calling thread never write at the same time
+    std::condition_variable recordsPending;
+    std::string pendingBytes;
+    size_t pendingRecordsAmount {0};
+    bool stopping {false};
+};
+
+
+/**
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                         *
+ *           CUSTOM MADE FUNCTIONS PROTOTYPES              *
+ *                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ **/
+
+
+// Shows the program's welcoming message
+void showProgramWelcome();
+
+// Displays the menu to the user
+void displayMenu(bool, bool);
+
+// Processes the selection made by the user from the menu
+void processMenuSelection(char, const ProgramOptions &, EmployeeRegistry &, PaymentLedger &, ThreadPool &, WriteAheadLog &);
+
+// Validates and returns if the given selection is among the allowed selections from the Menu
+bool isValidMenuSelection(char input, const std::vector<char> &);
+
+// Adds an Employee structure variable to the reference of a given EmployeeRegistry
+void addEmployee(EmployeeRegistry &, WriteAheadLog &);
+
+// Removes an Employee structure variable from the reference of a given EmployeeRegistry, by its given id
+void deleteCurrentEmployee(EmployeeRegistry &, WriteAheadLog &);
+
+// Shows the table with all the current employees
+void showCurrentEmployeesTable(const EmployeeRegistry &);
+
+// Adds a Payment structure variable, associated to a specific Employee, to the reference of a given PaymentLedger
+void addPayment(PaymentLedger &, const EmployeeRegistry &, WriteAheadLog &);
+
+// Gets the length of the pargest full name among the current employees of a given EmployeeRegistry (0 if there are none)
+int getLargestFullNameLength(const EmployeeRegistry &employeeRegistry);
+
+// Gets the length of the pargest full name among the employees that have received the payments of some given PaymentColumns
+int getLargestFullNameLength(const PaymentColumns &columns);
+
+void showEmployeesTable(const EmployeeRegistry &);
+
+// Renders an appropiate length "line" conformed by dashes (& its line break), as part of a good looking Employees table
+std::string renderLineUnderEmployeesTableRow(int);
+
+// Adds a Payment structure variable to the reference of a given PaymentLedger
+void addPaymentToEmployee(PaymentLedger &, const Employee &, WriteAheadLog &);
+
+// Appends a given Payment structure variable to the reference of a given PaymentLedger, keeping its per-employee & per pay date indexes updated
+void insertPayment(PaymentLedger &, const Payment &);
+
+// Rebuilds the Payment structure variable stored at a given position of a given PaymentLedger
+Payment getPayment(const PaymentLedger &, size_t);
+
+// Adds the already computed figures of a payment with a given pay date into the reference of a given PayDateIndex, updating only the path of its leaf (unless the tree must be rebuilt)
+void addPaymentFiguresToPayDateIndex(PayDateIndex &, int32_t, const PaymentFigures &);
+
+// Creates the PayDateIndex of all the payments held by some given PaymentColumns, adding up each pay date's payments in the order they were made
+PayDateIndex createPayDateIndex(const PaymentColumns &);
+
+// Rebuilds the whole tree of a given PayDateIndex from its pay dates' additions, with the smallest power of 2 leaves that fits them all
+void rebuildPayDateIndexTree(PayDateIndex &);
+
+// Generates a PayrollReport with the addition of the payments of a given PaymentLedger whose pay dates are within a given range (both included), in logarithmic time
+PayrollReport createAdditionPayrollReportOfPayDates(const PaymentLedger &, int32_t, int32_t);
+
+// Gets the first & last dates (as days since 1970-01-01) of a given quarter (1 to 4) of a given year, into the given references
+void getQuarterDates(int, int, int32_t &, int32_t &);
+
+// Gets the first date (as days since 1970-01-01) of the year of a given date, so the range from it to the given date is the year to date
+int32_t getFirstDateOfYear(int32_t);
+
+// Prints on the terminal all the payments made by the company, including those to ex employees, a given amount of them at a time (0 means all at once)
+void printAllThePayments(const PaymentLedger &, size_t);
+
+// Gets the option selected by the user, from the options to move through the pages of payments
+char getPaymentsPageSelection(bool);
+
+// Opens a PaymentCursor at the first of all the payments of a given PaymentLedger, that goes through them a given amount at a time (0 means all at once)
+PaymentCursor openPaymentCursor(const PaymentLedger &, size_t);
+
+// Moves a given PaymentCursor to a given payment number (or to its end, if there are not that many payments)
+void seekPaymentCursor(PaymentCursor &, size_t);
+
+// Narrows a given PaymentCursor to the payments of a given employee's id, from the first one. Returns false (leaving the cursor untouched) if that employee has no payments
+bool filterPaymentCursor(PaymentCursor &, const EmployeeId &);
+
+// Widens a given PaymentCursor back to all the payments, from the first one
+void unfilterPaymentCursor(PaymentCursor &);
+
+// Renders an appropiate length "line" conformed by dashes (& its line break), as part of a good looking Payments table
+std::string renderLineUnderPaymentsTableRow(int);
+
+// Prints on the terminal the next page of payments of a given PaymentCursor, moving it past them
+void printPaymentsPage(PaymentCursor &);
+
+// Gets the option selected by the user, from the menu's options
+char getMenuSelection(bool, bool);
+
+// Prints on the terminal a PayrollReport for a specific Employee
+void generateAndPrintCurrentEmployeePayrollReports(const PaymentLedger &, const EmployeeRegistry &, ThreadPool &);
+
+// Prints on the terminal both PayrollReports, addition & average, for the whole company
+void generateAndPrintCompanyPayrollReports(const PaymentLedger &);
+
+// Generates both EmployeePayrollReports, addition & average, of a given current employee (that must have payments), with all the report workers of a given ThreadPool
+PayrollReportSummary<EmployeePayrollReport> createCurrentEmployeePayrollReportSummary(const PaymentLedger &, const Employee &, ThreadPool &);
+
+// Prints on the terminal both EmployeePayrollReports, addition & average, of every employee that has received payments (current & ex employees)
+void generateAndPrintAllEmployeesPayrollReports(const PaymentLedger &);
+
+// Prints on the terminal both PayrollReports, addition & average, of the company's payments within a range of pay dates, a quarter or the year to date
+void generateAndPrintPayDatesPayrollReports(const PaymentLedger &);
+
+// Inserts a given Employee structure variable into the reference of a given EmployeeRegistry, indexing it by its id
+void insertEmployee(EmployeeRegistry &, Employee);
+
+// Determines if a given emloyeeID belongs to the current ones
+bool existEmployee(const EmployeeRegistry &, const EmployeeId &);
+
+// Determines if a given emloyee's id has associated at least one payment
+bool employeeHasPayments(const PaymentLedger &, const EmployeeId &);
+
+// Retrieves an Employee structure variable by a given employee's id (that must exist)
+const Employee &getEmployeById(const EmployeeRegistry &, const EmployeeId &);
+
+// Deletes an Employee structure variable by a given employee's id
+void deleteEmployeById(EmployeeRegistry &, const EmployeeId &);
+
+// Asks with a given message for the id of a current employee of a given EmployeeRegistry, until getting one
+EmployeeId getCurrentEmployeeIdFromMessage(const EmployeeRegistry &, const std::string &);
+
+// Generates a new random employee's id (a version 4 UUID), out of a single 128-bit draw
+EmployeeId generateEmployeeId();
+
+// Generates a new random employee's id (a version 4 UUID), out of a single 128-bit draw from a given generator
+EmployeeId generateEmployeeId(std::mt19937_64 &);
+
+// Writes the text of a given employee's id (EMPLOYEE_ID_TEXT_LENGTH characters) into a given buffer. Returns where it ended
+char *formatEmployeeId(char *, const EmployeeId &);
+
+// Formats a given employee's id as text, to be shown. Format: bdc0a2fb-d39e-4242-9a0a-4e760153f18d
+std::string employeeIdToString(const EmployeeId &);
+
+// Reads a given text as an employee's id (its hexadecimal digits in either case, with its 4 dashes) into the reference of a given EmployeeId. Returns false if it's not one
+bool parseEmployeeId(std::string_view, EmployeeId &);
+
+// Computes once each one of the derived figures of a given Payment structure variable
+PaymentFigures computePaymentFigures(const Payment &);
+
+// Computes once each one of the derived figures of a payment, given its worked hours, its regular rate & its payroll policy (whose rules get looked up, with no branches on it)
+PaymentFigures computePaymentFigures(double, double, PayrollPolicy);
+
+// Computes once each one of the derived figures of a payment, given its worked hours, its regular rate & the payroll rules it follows
+PaymentFigures computePaymentFigures(double, double, const PayrollRules &);
+
+// Computes once each one of the derived figures of a payment, given its worked hours & its regular rate, specialised for a given payroll policy (its rules become constants)
+template<PayrollPolicy POLICY>
+PaymentFigures computePaymentFigures(double, double);
+
+// Calls a given callable with a given payroll policy as a compile time constant (an integral_constant), so the callable gets specialised for every policy
+template<typename Callable>
+void dispatchPayrollPolicy(PayrollPolicy, Callable);
+
+// Calls a given callable once per payroll policy, always in the same order, each one as a compile time constant (an integral_constant)
+template<typename Callable>
+void forEachPayrollPolicy(Callable);
+
+// Reads a given text as a payroll policy (its name, in either case) into the reference of a given PayrollPolicy. Returns false if it's not one
+bool parsePayrollPolicy(std::string_view, PayrollPolicy &);
+
+// Appends the numeric data of a given Payment structure variable to the reference of some given PaymentColumns, encoding its employee's id
+void appendPaymentToColumns(PaymentColumns &, const Payment &);
+
+// Adds an employee to the dictionary of some given PaymentColumns, given its id & names (interning its full name). Returns its new code
+uint32_t addEmployeeToColumnsDictionary(PaymentColumns &, const EmployeeId &, std::string_view, std::string_view);
+
+// Gets a view of the employee's id of a given code, from the dictionary of some given PaymentColumns
+const EmployeeId &getEmployeeIdOfCode(const PaymentColumns &, uint32_t);
+
+// Gets a view of the employee's full name of a given code, from the dictionary of some given PaymentColumns
+std::string_view getEmployeeFullNameOfCode(const PaymentColumns &, uint32_t);
+
+// Gets a view of the employee's first name of a given code, from the dictionary of some given PaymentColumns
+std::string_view getEmployeeFirstNameOfCode(const PaymentColumns &, uint32_t);
+
+// Gets a view of the employee's last name of a given code, from the dictionary of some given PaymentColumns
+std::string_view getEmployeeLastNameOfCode(const PaymentColumns &, uint32_t);
+
+// Creates an empty EmployeePayrollReport associated to a given employee (through the texts interned by the dictionary of a given PaymentLedger,
+// where every employee with payments is. One without them only gets its id associated)
+EmployeePayrollReport createEmptyEmployeePayrollReport(const PaymentLedger &, const Employee &);
+
+// Generates a PayrollReport with the addition of all the payments held by some given PaymentColumns, through the fastest aggregation kernel available
+PayrollReport createAdditionPayrollReport(const PaymentColumns &);
+
+// Aggregation kernel: adds into a PayrollReport the payments of some given contiguous columns (hours worked, regular rates & payroll policies),
+// using the AVX2 kernels when the CPU supports them. Told if the payments follow a mixed set of payroll policies
+PayrollReport aggregatePaymentColumns(const double *, const double *, const PayrollPolicy *, size_t, bool);
+
+// Aggregation kernel: accumulates the payments of some given contiguous columns into the reference of some given per-lane accumulators, using the AVX2 kernels when the CPU supports them.
+// The first payment goes to the first lane, so a run of columns can be accumulated piece by piece (as long as every piece but the last has a multiple of 4 payments).
+// Payments that all follow one payroll policy go through the kernel specialised for it, & a mixed set of them through one masked pass per policy
+void accumulatePaymentColumns(const double *, const double *, const PayrollPolicy *, size_t, bool, KernelLanes &);
+
+// Portable aggregation kernels: picks the one specialised for the payroll policy of the payments (or runs one masked pass per policy, when they are mixed)
+void accumulatePaymentColumnsScalar(const double *, const double *, const PayrollPolicy *, size_t, bool, KernelLanes &);
+
+// Portable aggregation kernel, specialised for a given payroll policy: same lane layout (& therefore the very same results) as the AVX2 one, but one payment at a time.
+// A masked one adds zeros for the payments of the other policies, without branching on them
+template<PayrollPolicy POLICY, bool IS_MASKED>
+void accumulatePolicyPaymentColumnsScalar(const double *, const double *, const PayrollPolicy *, size_t, KernelLanes &);
+
+#ifdef PAYROLL_HAS_AVX2_KERNELS
+// AVX2 aggregation kernels: picks the one specialised for the payroll policy of the payments (or runs one masked pass per policy, when they are mixed)
+void accumulatePaymentColumnsAvx2(const double *, const double *, const PayrollPolicy *, size_t, bool, KernelLanes &);
+
+// AVX2 aggregation kernel, specialised for a given payroll policy: processes 4 payments at a time, one per lane.
+// A masked one adds zeros for the payments of the other policies, without branching on them
+template<PayrollPolicy POLICY, bool IS_MASKED>
+__attribute__((target("avx2"))) void accumulatePolicyPaymentColumnsAvx2(const double *, const double *, const PayrollPolicy *, size_t, KernelLanes &);
+#endif
+
+// Turns the per-lane accumulators of an aggregation kernel into a PayrollReport, always adding the lanes in the same order
+PayrollReport combineKernelLanes(const KernelLanes &, size_t);
+
+// Generates in parallel a PayrollReport with the addition of all the payments held by some given PaymentColumns, merging the chunks' partial reports deterministically
+PayrollReport createAdditionPayrollReportInParallel(const PaymentColumns &, ThreadPool &);
+
+// Generates in parallel a PayrollReport with the addition of all the payments held by some given contiguous columns (hours worked, regular rates & payroll policies),
+// merging the chunks' partial reports deterministically. Told if the payments follow a mixed set of payroll policies
+PayrollReport createAdditionPayrollReportInParallel(const double *, const double *, const PayrollPolicy *, size_t, bool, ThreadPool &);
+
+// Generates in parallel a PayrollReport with the addition of all the payments of a given ledger file, straight from its mapped pages (no copies at all)
+PayrollReport createAdditionPayrollReport(const MappedLedgerFile &, ThreadPool &);
+
+// Opens a given ledger file into the reference of a given MappedLedgerFile, validating its layout. Tells if it was opened, if it does not exist, or if it can't be used
+LedgerFileOpening openLedgerFile(const std::string &, MappedLedgerFile &);
+
+// Loads the whole system (employees & payments) from a given opened ledger file, into the references of a given EmployeeRegistry & PaymentLedger
+void loadLedgerFile(const MappedLedgerFile &, EmployeeRegistry &, PaymentLedger &);
+
+// Saves the whole system (employees & payments) into a given ledger file, replacing it atomically. Returns false if it could not be written
+bool saveLedgerFile(const std::string &, const EmployeeRegistry &, const PaymentLedger &, uint64_t = 0);
+
+// Syncs to disk the contents of the (already written & closed) file at a given path. Returns false if it could not be synced
+bool syncFileToDisk(const std::string &);
+
+// Syncs to disk the directory holding the file at a given path, so a file just renamed inside it survives a power loss. Returns false if it could not be synced
+bool syncParentDirectoryToDisk(const std::string &);
+
+// Computes the CRC-32 checksum of a given amount of bytes, continuing a given previous checksum
+uint32_t computeCrc32(const char *, size_t, uint32_t = 0);
+
+// Records in a given WriteAheadLog the addition of a given Employee structure variable
+void logEmployeeAddition(WriteAheadLog &, const Employee &);
+
+// Records in a given WriteAheadLog the deletion of an employee, given its id
+void logEmployeeDeletion(WriteAheadLog &, const EmployeeId &);
+
+// Records in a given WriteAheadLog the addition of a given Payment structure variable
+void logPaymentAddition(WriteAheadLog &, const Payment &);
+
+// Appends a given string to a given log record's payload, preceded by its length
+void appendLogString(std::string &, std::string_view);
+
+// Appends a given double to a given log record's payload
+void appendLogDouble(std::string &, double);
+
+// Appends a given 32 bits integer to a given log record's payload
+void appendLogInt32(std::string &, int32_t);
+
+// Appends a given employee's id to a given log record's payload, as its 16 bytes
+void appendLogEmployeeId(std::string &, const EmployeeId &);
+
+// Appends a given payroll policy to a given log record's payload, as a single byte
+void appendLogPayrollPolicy(std::string &, PayrollPolicy);
+
+// Reads the next string from a given log record's payload, advancing a given position. Returns false if the payload ends before it does
+bool readLogString(const std::string &, size_t &, std::string &);
+
+// Reads the next double from a given log record's payload, advancing a given position. Returns false if the payload ends before it does
+bool readLogDouble(const std::string &, size_t &, double &);
+
+// Reads the next 32 bits integer from a given log record's payload, advancing a given position. Returns false if the payload ends before it does
+bool readLogInt32(const std::string &, size_t &, int32_t &);
+
+// Reads the next employee's id from a given log record's payload, advancing a given position. Returns false if the payload ends before it does
+bool readLogEmployeeId(const std::string &, size_t &, EmployeeId &);
+
+// Reads the next payroll policy from a given log record's payload, advancing a given position. Returns false if the payload ends before it does, or it's not a known policy
+bool readLogPayrollPolicy(const std::string &, size_t &, PayrollPolicy &);
+
+// Applies a given log record to the references of a given EmployeeRegistry & PaymentLedger. Returns false if its payload is not valid
+bool applyLogRecord(const LogRecordHeader &, const std::string &, EmployeeRegistry &, PaymentLedger &);
+
+// Applies the records of a given write-ahead log file newer than a given sequence number to the references of a given EmployeeRegistry & PaymentLedger.
+// Stops at the first torn or corrupted record, cutting the log there. Returns how many records were applied, & leaves the last sequence number found in the given reference
+size_t replayWriteAheadLog(const std::string &, uint64_t, EmployeeRegistry &, PaymentLedger &, uint64_t &);
+
+// Folds a given WriteAheadLog into a snapshot of the whole system saved into a given ledger file, & empties the log. Returns false if the snapshot could not be saved
+bool compactWriteAheadLog(const std::string &, WriteAheadLog &, const EmployeeRegistry &, const PaymentLedger &);
+
+// Reads a given CSV file by blocks, calling a given handler with the fields of each one of its non empty lines (& the line's number). Returns false if it can not be opened
+template<typename CsvRowHandler>
+bool streamCsvFile(const std::string &, CsvRowHandler);
+
+// Splits a given CSV line into the reference of a given vector of fields (views into the line, without their quotes). Returns false if its quotes are not balanced
+bool splitCsvLine(std::string_view, std::vector<std::string_view> &);
+
+// Assigns a given CSV field to the reference of a given string, turning its escaped quotes ("") into single ones
+void assignCsvField(std::string &, std::string_view);
+
+// Parses a given CSV field as a finite floating point number, into the reference of a given double. Returns false if the whole field is not such a number
+bool parseCsvDouble(std::string_view, double &);
+
+// Determines if a given CSV line is just the header with the given column names
+bool isCsvHeader(const std::vector<std::string_view> &, const std::vector<std::string_view> &);
+
+// Reports a rejected row of a given CSV import (only the first ones get printed)
+void reportCsvRowError(CsvImportReport &, size_t, const std::string &);
+
+// Imports into the reference of a given EmployeeRegistry the employees of a given CSV file (id,first_name,last_name,reg_rate[,payroll_policy]; an empty id gets a new one)
+CsvImportReport importEmployeesCsv(const std::string &, EmployeeRegistry &);
+
+// Imports into the reference of a given PaymentLedger the payments of a given CSV file (employee_id,hours_worked), for the current employees of a given EmployeeRegistry
+CsvImportReport importPaymentsCsv(const std::string &, const EmployeeRegistry &, PaymentLedger &);
+
+// Prints on the terminal the outcome of a given CSV import
+void printCsvImportReport(const CsvImportReport &, const std::string &);
+
+// Generates into the references of a given EmployeeRegistry & PaymentLedger a given SyntheticWorkload, drawing its employees & payments by blocks with the workers of a given ThreadPool
+WorkloadGenerationReport generateSyntheticWorkload(const SyntheticWorkload &, EmployeeRegistry &, PaymentLedger &, ThreadPool &);
+
+// Derives from a given seed & a given value a new seed, as unrelated to the given one as to the seeds derived from any other value (a SplitMix64 step)
+uint64_t deriveWorkloadSeed(uint64_t, uint64_t);
+
+// Draws from a given generator a fraction in [0, 1), the same one on every platform (unlike uniform_real_distribution)
+double drawFraction(std::mt19937_64 &);
+
+// Prints on the terminal the outcome of generating a synthetic workload
+void printWorkloadGenerationReport(const WorkloadGenerationReport &);
+
+// Reads into the reference of a given vector the what-if scenarios of a given CSV file (name,max_reg_hours,ot_multiplier,fica_rate,ss_med_rate; an empty rule keeps the current one)
+CsvImportReport readPayrollScenariosCsv(const std::string &, std::vector<PayrollScenario> &);
+
+// Simulates the company's PayrollReport under the what-if scenarios of a given CSV file, over all the payments of a given PaymentLedger (with the workers of a given ThreadPool),
+// & prints a comparison table per scenario. Returns the program's exit status
+int simulateAndPrintPayrollScenarios(const std::string &, const PaymentLedger &, ThreadPool &);
+
+// Prints on the terminal the comparison of a given scenario's addition PayrollReport with the current one
+void printPayrollScenarioComparisonTable(TableRenderer &, const PayrollScenario &, const PayrollReport &, const PayrollReport &);
+
+// Folds a given WriteAheadLog into the ledger file once it has reached the amount of records given by some ProgramOptions (or half the records
+// of the snapshot itself, if that's more: rewriting a big snapshot for just a few changes would cost more than replaying them ever will)
+void compactWriteAheadLogIfNeeded(const ProgramOptions &, WriteAheadLog &, const EmployeeRegistry &, const PaymentLedger &);
+
+// Runs the commands read from a given input stream, one per line & with no menu at all, writing a JSON line with the result of each one (& a final summary) to a given output stream.
+// Returns the program's exit status: 0 only if every command succeeded
+int runHeadlessCommands(std::istream &, std::ostream &, const ProgramOptions &, EmployeeRegistry &, PaymentLedger &, ThreadPool &, WriteAheadLog &);
+
+// Runs a single headless command, given its (already split) words, appending the rest of its JSON result to the reference of a given string. Returns false if it failed
+bool runHeadlessCommand(const std::vector<std::string_view> &, std::string &, EmployeeRegistry &, PaymentLedger &, ThreadPool &, WriteAheadLog &);
+
+// Splits a given command line into the reference of a given vector of words (separated by blanks, or surrounded by double quotes). Returns false if its quotes are not balanced
+bool splitCommandLine(std::string_view, std::vector<std::string_view> &);
+
+// Appends a given string to the reference of a given JSON text, as a JSON string (quoted & escaped)
+void appendJsonString(std::string &, std::string_view);
+
+// Appends a given number to the reference of a given JSON text, as the shortest JSON number that reads back exactly as it
+void appendJsonNumber(std::string &, double);
+
+// Appends a given employee's id to the reference of a given JSON text, as a JSON string
+void appendJsonEmployeeId(std::string &, const EmployeeId &);
+
+// Appends a given PayrollReport to the reference of a given JSON text, as a JSON object with all its fields (the derived ones too)
+void appendJsonPayrollReport(std::string &, const PayrollReport &);
+
+// Gets a view of a given string stored inside the string table of a given ledger file
+std::string_view getLedgerFileString(const MappedLedgerFile &, const LedgerFileString &);
+
+// Gets the company's running addition PayrollReport of a given ledger file (the one stored in its header, or the one rebuilt when opening a version 5 file)
+PayrollReport getLedgerFilePayrollReport(const MappedLedgerFile &);
+
+// Prints on the terminal both PayrollReports, addition & average, of the whole company, straight from a given ledger file (without loading it). Returns false if there is no valid ledger file to print them from
+bool printLedgerFileCompanyPayrollReports(const std::string &, ThreadPool &);
+
+// Generates in parallel a EmployeePayrollReport with the addition of all the payments related to a given employee, merging the chunks' partial reports deterministically
+EmployeePayrollReport createAdditionEmployeePayrollReportInParallel(const PaymentLedger &, const Employee &, ThreadPool &);
+
+// Adds up a given amount of chunks, running the given chunk's aggregation as the tasks of a given ThreadPool, & merging their partial reports as a tree
+PayrollReport aggregateChunksInParallel(size_t, const std::function<PayrollReport(size_t)> &, ThreadPool &);
+
+// Merges two given addition PayrollReports into a single one, as if all their payments had been added into the same report
+PayrollReport mergePayrollReports(const PayrollReport &, const PayrollReport &);
+
+// Reduces a given vector of partial PayrollReports into a single one, always merging neighbours pairwise (a balanced tree), so the result depends only on the partial reports
+PayrollReport reducePayrollReportsAsTree(std::vector<PayrollReport>);
+
+// Simulates the addition PayrollReport of all the payments of some given PaymentColumns under each one of some given what-if scenarios. The scenarios get vectorized (one per lane),
+// & the chunks of payments get spread among the workers of a given ThreadPool, merged as a tree (so the results never depend on the amount of workers)
+std::vector<PayrollReport> simulatePayrollScenarios(const PaymentColumns &, const std::vector<PayrollScenario> &, ThreadPool &);
+
+// What-if simulation kernel: adds the payments of some given contiguous columns (hours worked, regular rates & payroll policies) into the given reports
+// of some given scenarios (one report per scenario), through the AVX2 kernel when the CPU supports it
+void simulatePaymentColumns(const double *, const double *, const PayrollPolicy *, size_t, const PayrollScenario *, size_t, PayrollReport *);
+
+// Portable what-if simulation kernel: every scenario adds the payments one by one, with the very same operations (& therefore the very same results) as the AVX2 kernel
+void simulatePaymentColumnsScalar(const double *, const double *, const PayrollPolicy *, size_t, const PayrollScenario *, size_t, PayrollReport *);
+
+#ifdef PAYROLL_HAS_AVX2_KERNELS
+// AVX2 what-if simulation kernel: 4 scenarios at a time (one per lane) go through each payment, each one adding the payments in their order
+__attribute__((target("avx2"))) void simulatePaymentColumnsAvx2(const double *, const double *, const PayrollPolicy *, size_t, const PayrollScenario *, size_t, PayrollReport *);
+#endif
+
+// Checks that the simulation of some given scenarios matches bit for bit the one of the portable kernel, & that the scenario with the current rules (the first one)
+// matches the company's running addition PayrollReport: its money exactly, & its hours closely (they add up in different orders). Aborts if not
+void verifyPayrollSimulation(const PaymentLedger &, const std::vector<PayrollScenario> &, const std::vector<PayrollReport> &);
+
+// Checks that the aggregation kernels match bit for bit the Payment's member functions (payment by payment), that the AVX2 ones match the scalar ones lane by lane
+// (over blocks of payments, masked or not), & that all kernels agree with each other. Aborts if not
+void verifyPaymentColumnKernels(const PaymentLedger &);
+
+// Adds the data of a given Payment structure variable into the reference of a given (addition) PayrollReport
+void addPaymentToPayrollReport(PayrollReport &, const Payment &);
+
+// Adds the already computed figures of a payment into the reference of a given (addition) PayrollReport
+void addPaymentFiguresToPayrollReport(PayrollReport &, const PaymentFigures &);
+
+// Generates the addition & average EmployeePayrollReports of every employee that has received payments (current & ex employees), grouping all the payments in a single pass
+std::vector<PayrollReportSummary<EmployeePayrollReport>> createAllEmployeesPayrollReportSummaries(const PaymentLedger &, EmployeeReportsOrder);
+
+// Generates in a single pass the addition & average PayrollReports (and optionally their dispersion) of all the Payment structure variables of the whole company
+PayrollReportSummary<PayrollReport> createPayrollReportSummary(const std::vector<Payment> &, bool = false);
+
+// Generates in a single pass the addition & average EmployeePayrollReports (and optionally their dispersion) of all the Payment structure variables related to a given employee
+PayrollReportSummary<EmployeePayrollReport> createEmployeePayrollReportSummary(const PaymentLedger &, const Employee &, bool = false);
+
+// Fused report engine: builds a PayrollReportSummary, starting from a given (empty) report, over the figures of the payments that a given visitor passes to its callback
+template<typename Report, typename PaymentsVisitor>
+PayrollReportSummary<Report> summarizePayments(const Report &, PaymentsVisitor, bool);
+
+// Generates a EmployeePayrollReport with the addition of all the Payment structure variables related to a given employee
+EmployeePayrollReport createAdditionEmployeePayrollReport(const PaymentLedger &, const Employee &);
+
+// Generates a PayrollReport with the addition of all the Payment structure variables's data of the whole company across the time
+PayrollReport createAdditionPayrollReport(const std::vector<Payment> &);
+
+// Generates a EmployeePayrollReport with the average of all the Payment structure variables related to a given employee
+EmployeePayrollReport createAverageEmployeePayrollReport(const PaymentLedger &, const Employee &);
+
+// Generates a PayrollReport with the average of all the Payment structure variables's data of the whole company across the time
+PayrollReport createAveragePayrollReport(const std::vector<Payment> &);
+
+// Generates a PayrollReport with the average data of a given addition PayrollReport, by dividing each field by its payments amount
+PayrollReport createAveragePayrollReportFromAddition(const PayrollReport &);
+
+// Gets the average of a given addition of money among a given amount of payments, rounded to the cent (no money at all, when there are no payments)
+Money averageMoney(Money, int);
+
+// Recomputes from scratch the company's addition PayrollReport & aborts if it does not match exactly the running one kept by the PaymentLedger
+void verifyCompanyAdditionPayrollReport(const PaymentLedger &);
+
+// Recomputes from scratch the PayDateIndex of a given PaymentLedger & aborts if it does not match exactly the one kept up to date, node by node
+void verifyPayDateIndex(const PaymentLedger &);
+
+// Prints on the console both, the addition & average PayrollReports of the company
+void printCompanyPayrollReports(const PayrollReport &, const PayrollReport &);
+
+// Prints on the console both, the addition & average PayrollReports of the company's payments within a given range of pay dates (both included)
+void printPayDatesPayrollReports(int32_t, int32_t, const PayrollReport &, const PayrollReport &);
+
+// Prints on the console both, the addition & average given EmployeePayrollReports
+void printEmployeePayrollReports(const EmployeePayrollReport &, const EmployeePayrollReport &);
+
+// Prints on the console a table with the addition & average figures of a given batch of EmployeePayrollReports, one employee per row
+void printAllEmployeesPayrollReports(const std::vector<PayrollReportSummary<EmployeePayrollReport>> &);
+
+// Renders an appropiate length "line" conformed by dashes (& its line break), of a given table width, as part of a good looking table of EmployeePayrollReports
+std::string renderLineUnderEmployeesPayrollReportsTableRow(int);
+
+// Prints either a EmployeePayrollReport or a PayrollReport structure variable, with addition and average data,
+// as we pass as argument a father struct PayrollReport variable, and from the received parameter we won't use the employee's id anyway at this point (either done before or not needed)
+void printPayrollReportsTable(const PayrollReport &, const PayrollReport &);
+
+// Prints on the console goodbyes to the user
+void sayGoodbyeToTheUser();
+
+#ifdef PAYROLL_INSTRUMENTATION
+// Adds a given amount of events to a given InstrumentedCounter
+void countInstrumentedEvents(InstrumentedCounter, uint64_t);
+
+// Adds one call of a given InstrumentedOperation, with its latency in nanoseconds & its allocations, to the instrumentation's statistics
+void recordOperationCall(InstrumentedOperation, uint64_t, uint64_t, uint64_t);
+
+// Gets the latency bucket of a given amount of nanoseconds: exact below 8, & then 4 buckets per power of 2
+size_t getLatencyBucket(uint64_t);
+
+// Gets the largest amount of nanoseconds that falls into a given latency bucket
+uint64_t getLatencyBucketUpperBound(size_t);
+
+// Estimates a given percentile (from 0 to 1) of the latencies of a given OperationStats, from its buckets (never above its maximum)
+uint64_t estimateLatencyPercentile(const OperationStats &, double);
+
+// Prints on a given stream the instrumentation's statistics, as a table with a row per operation called (& then the counters)
+void printInstrumentationTable(std::ostream &);
+
+// Renders the instrumentation's statistics as a JSON object, with every operation called & every counter
+std::string renderInstrumentationJson();
+#endif
+
+#endif // PAYROLL_PRO_PAYROLL_H
@@ -0,0 +1,665 @@
+/**
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                   *
+ *   Payroll Pro 2.0 - The payroll tests                             *
+ *                                                                   *
+ *   Purpose:                                                        *
+ *   Checks the payroll core against reference implementations       *
+ *   (like the regular expressions & stod() the typed numbers used   *
+ *   to go through), with both exhaustive & random inputs, & every   *
+ *   report table against its golden output (tests/golden). Every    *
+ *   failed check gets printed, & makes the program exit with 1:     *
+ *                                                                   *
+ *   ctest --test-dir build --output-on-failure                      *
+ *                                                                   *
+ *   A table that changes on purpose gets its golden output written  *
+ *   again by running it with PAYROLL_UPDATE_GOLDEN_FILES=1.         *
+ *                                                                   *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ **/
+
+#include <regex>
+#include "payroll.h"
+
+using namespace std;
+
+
+/**
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                         *
+ *                   GLOBAL CONSTANTS                      *
+ *                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ **/
+
+constexpr uint64_t RANDOM_INPUTS_SEED = 20240718; // Fixed, so every run checks the very same random inputs
+constexpr size_t RANDOM_INPUTS_AMOUNT = 200000; // Random inputs checked by every property (on top of the exhaustive & the edge ones)
+constexpr uint64_t SWEPT_CENTS_AMOUNT = 10000000; // Every amount of money from $ 0.00 up to $ 99,999.99 gets formatted (on top of the random & the edge ones)
+constexpr uint64_t SWEPT_STREAM_CENTS_AMOUNT = 1000000; // The amounts from $ 0.00 up to $ 9,999.99 also get compared with the old stream based monetizing (which is way slower),
+                                                         // & so do the amounts halfway between two of them, where the rounding carries
+constexpr size_t MAX_REPORTED_FAILURES = 20; // Only the first failed checks get printed (all of them get counted)
+constexpr const char *DEFAULT_GOLDEN_FILES_DIRECTORY = "tests/golden"; // Where the golden outputs are, unless another directory is given as the first argument
+constexpr const char *GOLDEN_FILE_EXTENSION = ".txt";
+
+// Every string of up to EXHAUSTIVE_INPUTS_LENGTH characters over this alphabet gets checked: digits, signs, dots, exponents, blanks & letters
+constexpr string_view EXHAUSTIVE_INPUTS_ALPHABET = "07+-.eE x";
+constexpr size_t EXHAUSTIVE_INPUTS_LENGTH = 5;
+
+// Inputs that the exhaustive & random ones hardly ever reach: huge & tiny exponents, inf & nan, blanks around the number, & the limits of an int
+const vector<string> EDGE_INPUTS {
+    "", " ", "+", "-", ".", "e", "1e", "1e+", ".5", "5.", "+.5", "-5.", "1.5.5", "1x5", "0x10", "0x1p3", "+-1", "-+1", "--1", "++1",
+    "inf", "-inf", "+inf", "INF", "infinity", "nan", "NaN", "-nan", "nan(1)",
+    " 1", "1 ", " 1 ", "  -2.5e3  ", "\t1", "1\t", "1\n",
+    "1e308", "1.7976931348623157e308", "1.7976931348623159e308", "1e309", "-1e309", "1e99999999999",
+    "4.9e-324", "2.2250738585072014e-308", "1e-320", "1e-400", "-1e-400", "0e999999", "0.000000000000000000000000000001e-300",
+    "2147483647", "2147483648", "-2147483648", "-2147483649", "+2147483647", "99999999999999999999", "000000000000000000042", "-0", "+0",
+    "12345678901234567890.12345678901234567890", "1.00000000000000011102230246251565404236316680908203125"
+};
+
+// The employees of the golden tables (with fixed ids): a full name narrower than the title of its column, a regular one, & a very wide one
+const vector<Employee> GOLDEN_EMPLOYEES {
+    {.firstName = "Ann", .lastName = "Lee", .regRate = 10.00, .payrollPolicy = STANDARD_PAYROLL_POLICY},
+    {.firstName = "Jennifer", .lastName = "Williams", .regRate = 27.35, .payrollPolicy = STANDARD_PAYROLL_POLICY},
+    {.firstName = "Maximiliana Alexandrovna", .lastName = "Konstantinopolskaya-Vanderbilt de la Torre y Mendoza", .regRate = 30.00, .payrollPolicy = OVERTIME_EXEMPT_PAYROLL_POLICY}
+};
+const vector<string_view> GOLDEN_EMPLOYEE_IDS {"0f8e3c1a-5b7d-4e2f-9a6c-1d3b5f7e9a0c", "7c2d4e6f-8a0b-4c1d-8e3f-5a7b9c1d3e5f", "e9d8c7b6-a5f4-4e3d-b2c1-0a9f8e7d6c5b"};
+const vector<double> GOLDEN_HOURS_WORKED {40, 50, 12.25}; // Of the payments of every employee: regular hours only, with overtime (unless exempt), & a fraction
+constexpr string_view GOLDEN_FIRST_PAY_DATE = "2024-07-05"; // Each payment of an employee gets the pay date a week after the previous one
+
+// Regular rates that take the money of a payment to the limits of its rounding (& beyond them): the largest ones that still round, the ones that saturate, infinities & NaN
+const vector<double> EXTREME_REG_RATES {25.0, 0x1p51 / 4000, 0x1p51 / 2000, 1e15, 1e300, -1e15, numeric_limits<double>::infinity(), -numeric_limits<double>::infinity(),
+                                        numeric_limits<double>::quiet_NaN(), 0.005, 0.015, -0.025};
+
+
+/**
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                         *
+ *                   TESTING UTILITIES                     *
+ *                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ **/
+
+size_t failedChecksAmount = 0;
+
+// Counts a failed check if a given condition does not hold, printing it along with the given description (only the first ones get printed)
+void check(const bool condition, const string &description) {
+    if (condition) return;
+    if (failedChecksAmount++ < MAX_REPORTED_FAILURES) cerr << "FAILED: " << description << endl;
+}
+
+// Quotes a given input, so blanks & empty inputs can be told apart in the failures
+string quote(const string &input) {
+    return "\"" + input + "\"";
+}
+
+// Tells if two given doubles are the very same one, bit by bit (so even 0 & -0 are told apart)
+bool isSameDouble(const double a, const double b) {
+    return memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+// Gets the inputs every property gets checked with: all the strings up to a given length over a given alphabet, the edge ones, & a given amount of random ones
+vector<string> getCheckedInputs(const string_view alphabet, const size_t maxLength, const size_t randomInputsAmount) {
+    vector<string> inputs {""};
+    for (size_t first = 0, length = 1; length <= maxLength; length++) {
+        const size_t last = inputs.size();
+        for (size_t i = first; i < last; i++) {
+            for (const char character: alphabet) inputs.push_back(inputs[i] + character);
+        }
+        first = last;
+    }
+    inputs.insert(inputs.end(), EDGE_INPUTS.begin(), EDGE_INPUTS.end());
+
+    // The random ones are mostly well formed numbers (with any amount of digits & any exponent), but with a blank, a sign or a letter thrown in now & then
+    mt19937_64 generator(RANDOM_INPUTS_SEED);
+    const auto chance = [&](const int percentage) { return static_cast<int>(generator() % 100) < percentage; };
+    const auto appendDigits = [&](string &input, const size_t maxDigits) {
+        const size_t digitsAmount = 1 + generator() % maxDigits;
+        for (size_t digit = 0; digit < digitsAmount; digit++) input += static_cast<char>('0' + generator() % 10);
+    };
+    for (size_t i = 0; i < randomInputsAmount; i++) {
+        string input;
+        if (chance(5)) input += ' ';
+        if (chance(30)) input += "+-"[generator() % 2];
+        appendDigits(input, chance(10) ? 30 : 6);
+        if (chance(50)) {
+            input += '.';
+            appendDigits(input, chance(10) ? 30 : 4);
+        }
+        if (chance(30)) {
+            input += "eE"[generator() % 2];
+            if (chance(50)) input += "+-"[generator() % 2];
+            input += to_string(generator() % (chance(20) ? 1000 : 40));
+        }
+        if (chance(5)) input += ' ';
+        if (chance(3)) input.insert(generator() % (input.size() + 1), 1, "x.e+- "[generator() % 6]);
+        inputs.push_back(move(input));
+    }
+    return inputs;
+}
+
+
+/**
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                         *
+ *                   REFERENCE PARSERS                     *
+ *                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ **/
+
+// The typed numbers used to be validated by these regular expressions (the floating point one with its dot escaped, as it was always meant to be) & then parsed by stod()
+const regex REFERENCE_INTEGER_PATTERN(R"(^[+-]?[0-9]+$)");
+const regex REFERENCE_FLOATING_POINT_PATTERN(R"(^[+-]?[0-9]+(\.[0-9]+)?([eE][+-]?[0-9]+)?$)");
+const regex UNESCAPED_FLOATING_POINT_PATTERN(R"(^[+-]?[0-9]+(.[0-9]+)?([eE][+-]?[0-9]+)?$)"); // The one that was actually used (its dot matched any character)
+
+// Parses a given string through stod(), which throws when it doesn't fit in a double. It also throws for the tiniest doubles (the subnormal ones), which are
+// still accepted here: a number only fails when it doesn't fit at all, rounding to infinity or to 0
+bool parseReferenceDouble(const string &input, double &number, size_t &parsedLength) {
+    try {
+        number = stod(input, &parsedLength);
+        return true;
+    } catch (const out_of_range &) {
+        char *end;
+        number = strtod(input.c_str(), &end);
+        parsedLength = end - input.c_str();
+        return isfinite(number) && number != 0;
+    }
+}
+
+// Parses a given typed number just like getDouble() used to: through the regular expressions & stod()
+bool parseReferenceNumber(const string &input, double &number) {
+    if (!regex_match(input, REFERENCE_INTEGER_PATTERN) && !regex_match(input, REFERENCE_FLOATING_POINT_PATTERN)) return false;
+    size_t parsedLength;
+    return parseReferenceDouble(input, number, parsedLength);
+}
+
+// Parses a given integer just like the command-line options used to: through the regular expression & stoi(), which throws when it doesn't fit in an int
+bool parseReferenceInteger(const string &input, int &integer) {
+    if (!regex_match(input, REFERENCE_INTEGER_PATTERN)) return false;
+    try {
+        integer = stoi(input);
+        return true;
+    } catch (const out_of_range &) {
+        return false;
+    }
+}
+
+// Parses a given CSV field through stod(), with the blanks around it trimmed: the whole field must be a finite number, & a hexadecimal one doesn't count
+bool parseReferenceCsvDouble(const string &field, double &value) {
+    const size_t first = field.find_first_not_of(' ');
+    if (first == string::npos) return false;
+    const string trimmedField = field.substr(first, field.find_last_not_of(' ') - first + 1);
+    if (isspace(static_cast<unsigned char>(trimmedField.front())) || trimmedField.find_first_of("xX") != string::npos) return false; // stod() would skip tabs & read hexadecimals
+    try {
+        size_t parsedLength;
+        return parseReferenceDouble(trimmedField, value, parsedLength) && parsedLength == trimmedField.size() && isfinite(value);
+    } catch (const invalid_argument &) {
+        return false;
+    }
+}
+
+
+/**
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                         *
+ *                         TESTS                           *
+ *                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ **/
+
+// isFloatingPoint() & parseNumber() accept the very same typed numbers as the regular expressions did, & parse them into the very same doubles as stod()
+void testTypedNumbersParsing(const vector<string> &inputs) {
+    for (const string &input: inputs) {
+        const bool isReferenceFloatingPoint = regex_match(input, REFERENCE_FLOATING_POINT_PATTERN);
+        check(isFloatingPoint(input) == isReferenceFloatingPoint, "isFloatingPoint(" + quote(input) + ") should be " + (isReferenceFloatingPoint ? "true" : "false"));
+
+        // The old pattern's unescaped dot let through anything in its place (like "1x5"): every other typed number it accepted is still accepted
+        if (regex_match(input, UNESCAPED_FLOATING_POINT_PATTERN) && !isReferenceFloatingPoint) {
+            check(input.find('.') == string::npos || !isFloatingPoint(input), "isFloatingPoint(" + quote(input) + ") should only reject what the unescaped dot let through");
+        }
+
+        double number = 0, referenceNumber = 0;
+        const bool isParsed = parseNumber(input, number);
+        const bool isReferenceParsed = parseReferenceNumber(input, referenceNumber);
+        check(isParsed == isReferenceParsed, "parseNumber(" + quote(input) + ") should " + (isReferenceParsed ? "succeed" : "fail"));
+        if (isParsed && isReferenceParsed) check(isSameDouble(number, referenceNumber), "parseNumber(" + quote(input) + ") should parse the same double as stod()");
+    }
+}
+
+// parseInteger() accepts the very same integers as the regular expression did (as long as they fit in an int, as stoi() requires), with the very same values
+void testIntegersParsing(const vector<string> &inputs) {
+    for (const string &input: inputs) {
+        int integer = 0, referenceInteger = 0;
+        const bool isParsed = parseInteger(input, integer);
+        const bool isReferenceParsed = parseReferenceInteger(input, referenceInteger);
+        check(isParsed == isReferenceParsed, "parseInteger(" + quote(input) + ") should " + (isReferenceParsed ? "succeed" : "fail"));
+        if (isParsed && isReferenceParsed) check(integer == referenceInteger, "parseInteger(" + quote(input) + ") should parse the same int as stoi()");
+    }
+}
+
+// parseCsvDouble() accepts the very same fields as stod() (with the blanks around them trimmed, & only finite numbers), with the very same values
+void testCsvDoublesParsing(const vector<string> &inputs) {
+    for (const string &input: inputs) {
+        double value = 0, referenceValue = 0;
+        const bool isParsed = parseCsvDouble(input, value);
+        const bool isReferenceParsed = parseReferenceCsvDouble(input, referenceValue);
+        check(isParsed == isReferenceParsed, "parseCsvDouble(" + quote(input) + ") should " + (isReferenceParsed ? "succeed" : "fail"));
+        if (isParsed && isReferenceParsed) check(isSameDouble(value, referenceValue), "parseCsvDouble(" + quote(input) + ") should parse the same double as stod()");
+    }
+}
+
+
+// The cents that Money::fromCents() used to round to, by adding & subtracting the shifter (only right within 2^51 cents, & only without -ffast-math)
+int64_t roundReferenceCents(const double cents) {
+    return static_cast<int64_t>((cents + CENTS_ROUNDING_SHIFTER) - CENTS_ROUNDING_SHIFTER);
+}
+
+// Money::fromCents() rounds to the nearest cent (ties to even) just like the shifter did within its domain, & saturates beyond it (NaN included) instead of truncating
+void testMoneyRounding() {
+    mt19937_64 generator(RANDOM_INPUTS_SEED);
+    for (size_t i = 0; i < RANDOM_INPUTS_AMOUNT; i++) {
+        const double magnitude = ldexp(drawFraction(generator), static_cast<int>(generator() % 52)); // Below 2^51, from fractions of a cent up
+        const double cents = (generator() % 2 == 0 ? 1 : -1) * (i % 4 == 0 ? floor(magnitude) + 0.5 : magnitude); // A quarter of them are ties
+        check(Money::fromCents(cents).cents == roundReferenceCents(cents), "Money::fromCents(" + to_string(cents) + ") should round like the shifter");
+    }
+
+    const pair<double, int64_t> edgeRoundings[] = {{0.5, 0}, {1.5, 2}, {2.5, 2}, {-0.5, 0}, {-1.5, -2}, {-2.5, -2}, {0.49999999999999994, 0},
+                                                   {MAX_ROUNDED_CENTS, 0x7FFFFFFFFFFFF}, {-MAX_ROUNDED_CENTS, -0x7FFFFFFFFFFFF}, {0x1p51, 0x7FFFFFFFFFFFF}, {0x1p62, 0x7FFFFFFFFFFFF},
+                                                   {-0x1p70, -0x7FFFFFFFFFFFF}, {numeric_limits<double>::infinity(), 0x7FFFFFFFFFFFF},
+                                                   {-numeric_limits<double>::infinity(), -0x7FFFFFFFFFFFF}, {numeric_limits<double>::quiet_NaN(), -0x7FFFFFFFFFFFF}};
+    for (const auto &[cents, roundedCents]: edgeRoundings) {
+        check(Money::fromCents(cents).cents == roundedCents, "Money::fromCents(" + to_string(cents) + ") should be " + to_string(roundedCents));
+    }
+}
+
+// The AVX2 aggregation kernels round (& saturate) the money exactly like the scalar ones, even for payments whose money is out of the rounding's domain
+void testKernelsMoneyRounding() {
+#ifdef PAYROLL_HAS_AVX2_KERNELS
+    if (!__builtin_cpu_supports("avx2")) return;
+
+    // Every extreme rate goes through every lane, with & without overtime, plus a few payments left for the scalar tail of the AVX2 kernel
+    vector<double> hoursWorked, regRates;
+    for (const double regRate: EXTREME_REG_RATES) {
+        for (int lane = 0; lane < KERNEL_LANES; lane++) {
+            for (const double hours: GOLDEN_HOURS_WORKED) {
+                hoursWorked.push_back(hours);
+                regRates.push_back(regRate);
+            }
+        }
+    }
+    hoursWorked.resize(hoursWorked.size() + KERNEL_LANES - 1, MAX_HOURS_WORKED);
+    regRates.resize(regRates.size() + KERNEL_LANES - 1, EXTREME_REG_RATES[1]);
+
+    for (const PayrollPolicy payrollPolicy: {STANDARD_PAYROLL_POLICY, OVERTIME_EXEMPT_PAYROLL_POLICY}) {
+        const vector<PayrollPolicy> payrollPolicies(hoursWorked.size(), payrollPolicy);
+        KernelLanes scalarLanes, avx2Lanes;
+        accumulatePaymentColumnsScalar(hoursWorked.data(), regRates.data(), payrollPolicies.data(), hoursWorked.size(), false, scalarLanes);
+        accumulatePaymentColumnsAvx2(hoursWorked.data(), regRates.data(), payrollPolicies.data(), hoursWorked.size(), false, avx2Lanes);
+        for (int lane = 0; lane < KERNEL_LANES; lane++) {
+            for (int field = 0; field < KERNEL_MONEY_FIELDS; field++) {
+                check(scalarLanes.cents[field][lane] == avx2Lanes.cents[field][lane], "The AVX2 kernel should round the money field " + to_string(field) + " of the lane " +
+                                                                                        to_string(lane) + " like the scalar one (" + string(PAYROLL_RULES[payrollPolicy].name) + ")");
+            }
+        }
+    }
+#endif
+}
+
+
+// Inserts a comma every 3 digits of a given string of digits, just like the integer part of the money always was
+string groupReferenceDigits(string digits) {
+    for (int j = static_cast<int>(digits.length()) - 3; j > 0; j -= 3) digits.insert(j, ",");
+    return digits;
+}
+
+// An amount of money given in whole cents, grouped with its 2 decimals, built from integers alone
+string formatReferenceCents(const uint64_t cents) {
+    const string decimals = to_string(cents % 100);
+    return groupReferenceDigits(to_string(cents / 100)) + "." + (decimals.size() < 2 ? "0" : "") + decimals;
+}
+
+// Monetizes a given double just like monetizeDouble() used to: the integer part truncated & grouped, & the decimals rounded apart through a stream
+// (so a carry out of the decimals got lost: 1.995 became $ 1.00)
+string monetizeDoubleThroughStreams(const double doubleValue) {
+    const auto integerValue = static_cast<unsigned long long int>(doubleValue);
+    stringstream stream;
+    stream << fixed << setprecision(2) << doubleValue - static_cast<double>(integerValue);
+    return "$ " + groupReferenceDigits(to_string(integerValue)) + stream.str().substr(1, 3);
+}
+
+// formatGroupedFixed(), formatMoney(), humanizeUnsignedDouble() & monetizeDouble() write every amount of whole cents exactly as its integers say, from 0 up to
+// 2^51 cents (the largest ones that get rounded), & humanizeUnsignedInteger() groups every integer. They only differ from the old stream based monetizing
+// where its decimals rounded up to a whole unit (& the carry got lost)
+void testMoneyFormatting() {
+    // Every formatter gets checked at once for each amount (there are millions of them, so only the failed ones get described)
+    const auto checkCents = [](const uint64_t cents) {
+        const double amount = static_cast<double>(cents) / 100;
+        const string formattedAmount = formatReferenceCents(cents);
+        char buffer[FORMATTED_NUMBER_CAPACITY];
+        const char *groupedEnd = formatGroupedFixed(buffer, buffer + sizeof(buffer), amount, 2);
+        bool isFormatted = groupedEnd != nullptr && string_view(buffer, groupedEnd - buffer) == formattedAmount;
+        const char *moneyEnd = formatMoney(buffer, buffer + sizeof(buffer), amount, 2, false, "USD");
+        isFormatted = isFormatted && moneyEnd != nullptr && string_view(buffer, moneyEnd - buffer) == formattedAmount + " USD";
+        isFormatted = isFormatted && formatMoney(buffer, buffer + formattedAmount.size() + 1, amount) == nullptr; // No room for its symbol
+        isFormatted = isFormatted && humanizeUnsignedDouble(amount) == formattedAmount && monetizeDouble(amount) == "$ " + formattedAmount;
+        isFormatted = isFormatted && humanizeUnsignedInteger(cents) == groupReferenceDigits(to_string(cents));
+        if (!isFormatted) {
+            check(false, "formatGroupedFixed(), formatMoney(), humanizeUnsignedDouble() & monetizeDouble() should format " + quote(formattedAmount) + " exactly, & humanizeUnsignedInteger(" +
+                         to_string(cents) + ") should group every 3 digits");
+        }
+    };
+    for (uint64_t cents = 0; cents < SWEPT_CENTS_AMOUNT; cents++) checkCents(cents);
+    mt19937_64 generator(RANDOM_INPUTS_SEED);
+    for (size_t i = 0; i < RANDOM_INPUTS_AMOUNT; i++) {
+        checkCents(generator() % static_cast<uint64_t>(MAX_ROUNDED_CENTS + 1));
+        const uint64_t integer = generator() >> (generator() % 64); // Any amount of digits
+        if (humanizeUnsignedInteger(integer) != groupReferenceDigits(to_string(integer))) check(false, "humanizeUnsignedInteger(" + to_string(integer) + ") should group every 3 digits");
+    }
+    for (const uint64_t cents: {static_cast<uint64_t>(MAX_ROUNDED_CENTS) - 1, static_cast<uint64_t>(MAX_ROUNDED_CENTS), static_cast<uint64_t>(MAX_ROUNDED_CENTS) + 1}) checkCents(cents);
+    check(humanizeUnsignedInteger(numeric_limits<unsigned long long int>::max()) == "18,446,744,073,709,551,615", "humanizeUnsignedInteger() should group the largest integer");
+
+    // The old stream based monetizing only differs where the carry out of its decimals got lost (which never happens with whole cents)
+    const auto checkThroughStreams = [](const uint64_t halfCents) {
+        const double amount = static_cast<double>(halfCents) / 200;
+        const string money = monetizeDouble(amount), moneyThroughStreams = monetizeDoubleThroughStreams(amount);
+        if (money == moneyThroughStreams) return;
+        const auto integerValue = static_cast<unsigned long long int>(amount);
+        check(halfCents % 2 == 1 && moneyThroughStreams == "$ " + groupReferenceDigits(to_string(integerValue)) + ".00" && money == "$ " + groupReferenceDigits(to_string(integerValue + 1)) + ".00",
+              "monetizeDouble(" + to_string(amount) + ") is " + quote(money) + ", & should only differ from " + quote(moneyThroughStreams) + " by the lost carry");
+    };
+    for (uint64_t halfCents = 0; halfCents < 2 * SWEPT_STREAM_CENTS_AMOUNT; halfCents++) checkThroughStreams(halfCents);
+
+    // The amounts whose decimals used to lose their carry (0.995 is actually a bit below it, so it rounds down)
+    const pair<double, string_view> carriedAmounts[] = {{0.995, "$ 0.99"}, {1.995, "$ 2.00"}, {999.995, "$ 1,000.00"}, {1234567.995, "$ 1,234,568.00"}};
+    for (const auto &[amount, money]: carriedAmounts) check(monetizeDouble(amount) == money, "monetizeDouble(" + to_string(amount) + ") should be " + quote(string(money)));
+}
+
+// Runs a given printing function, capturing everything it prints on the console. The console's numbers are in fixed notation with 2 decimals,
+// just like in the interactive mode (where the prompts leave it set)
+string captureConsoleOutput(const function<void()> &printer) {
+    ostringstream output;
+    streambuf *const consoleBuffer = cout.rdbuf(output.rdbuf());
+    const ios::fmtflags consoleFlags = cout.flags();
+    const streamsize consolePrecision = cout.precision();
+    cout << fixed << setprecision(2);
+    printer();
+    cout.rdbuf(consoleBuffer);
+    cout.flags(consoleFlags);
+    cout.precision(consolePrecision);
+    return output.str();
+}
+
+// Checks a given output against the golden one with a given name, inside a given directory (or writes it as the golden one, when they are being updated)
+void checkGoldenOutput(const string &directory, const string &name, const string &output) {
+    const string path = directory + "/" + name + GOLDEN_FILE_EXTENSION;
+    if (getenv("PAYROLL_UPDATE_GOLDEN_FILES") != nullptr) {
+        ofstream(path, ios::binary) << output;
+        return;
+    }
+
+    ifstream file(path, ios::binary);
+    const string goldenOutput {istreambuf_iterator<char>(file), istreambuf_iterator<char>()};
+    check(file.is_open(), "the golden output " + path + " should exist");
+    if (!file.is_open() || output == goldenOutput) return;
+
+    // Only the first line that differs gets shown, which is usually enough to tell what changed
+    istringstream outputLines(output), goldenOutputLines(goldenOutput);
+    string outputLine, goldenOutputLine;
+    for (size_t lineNumber = 1; ; lineNumber++) {
+        const bool hasOutputLine = static_cast<bool>(getline(outputLines, outputLine));
+        const bool hasGoldenOutputLine = static_cast<bool>(getline(goldenOutputLines, goldenOutputLine));
+        if (hasOutputLine == hasGoldenOutputLine && outputLine == goldenOutputLine && hasOutputLine) continue;
+        check(false, "the output should match " + path + ", but its line " + to_string(lineNumber) + " is\n  " + quote(outputLine) + "\ninstead of\n  " + quote(goldenOutputLine));
+        return;
+    }
+}
+
+// Fills the references of a given EmployeeRegistry & PaymentLedger with the first given amount of golden employees, & the first given amount of payments of each one
+void fillGoldenPayroll(EmployeeRegistry &employeeRegistry, PaymentLedger &paymentLedger, const size_t employeesAmount, const size_t paymentsPerEmployee) {
+    int32_t firstPayDate;
+    parseIsoDate(GOLDEN_FIRST_PAY_DATE, firstPayDate);
+    for (size_t i = 0; i < employeesAmount; i++) {
+        Employee employee = GOLDEN_EMPLOYEES[i];
+        parseEmployeeId(GOLDEN_EMPLOYEE_IDS[i], employee.id);
+        insertEmployee(employeeRegistry, employee);
+    }
+    for (size_t payment = 0; payment < paymentsPerEmployee; payment++) {
+        for (const Employee &employee: employeeRegistry.employees) {
+            insertPayment(paymentLedger, Payment {.employeeId = employee.id, .firstName = employee.firstName, .lastName = employee.lastName, .hoursWorked = GOLDEN_HOURS_WORKED[payment],
+                                                  .regRate = employee.regRate, .payDate = firstPayDate + 7 * static_cast<int32_t>(payment), .payrollPolicy = employee.payrollPolicy});
+        }
+    }
+}
+
+// Every report table prints just like its golden output (tests/golden/<table>_<case>.txt): empty, with a single row, & with several ones (one of them very wide)
+void testReportTables(const string &goldenFilesDirectory) {
+    struct GoldenCase {
+        string name;
+        size_t employeesAmount;
+        size_t paymentsPerEmployee;
+    };
+    const vector<GoldenCase> goldenCases {{"empty", 0, 0}, {"single", 1, 1}, {"wide", GOLDEN_EMPLOYEES.size(), GOLDEN_HOURS_WORKED.size()}};
+
+    ThreadPool threadPool(1);
+    PayrollScenario currentScenario {.name = "current"};
+    copy(begin(PAYROLL_RULES), end(PAYROLL_RULES), begin(currentScenario.rulesByPolicy));
+    PayrollScenario costlierScenario = currentScenario;
+    costlierScenario.name = "costlier-overtime";
+    for (PayrollRules &rules: costlierScenario.rulesByPolicy) rules.otMultiplier = 2;
+    costlierScenario.rulesByPolicy[STANDARD_PAYROLL_POLICY].maxRegHours = 38;
+
+    for (const GoldenCase &goldenCase: goldenCases) {
+        EmployeeRegistry employeeRegistry;
+        PaymentLedger paymentLedger;
+        fillGoldenPayroll(employeeRegistry, paymentLedger, goldenCase.employeesAmount, goldenCase.paymentsPerEmployee);
+        const auto checkTable = [&](const string &table, const function<void()> &printer) {
+            checkGoldenOutput(goldenFilesDirectory, table + "_" + goldenCase.name, captureConsoleOutput(printer));
+        };
+
+        checkTable("employees", [&]() { showEmployeesTable(employeeRegistry); });
+        checkTable("payments", [&]() {
+            PaymentCursor paymentCursor = openPaymentCursor(paymentLedger, 0);
+            printPaymentsPage(paymentCursor);
+        });
+        checkTable("company_reports", [&]() {
+            printCompanyPayrollReports(paymentLedger.companyAdditionPayrollReport, createAveragePayrollReportFromAddition(paymentLedger.companyAdditionPayrollReport));
+        });
+        checkTable("pay_dates_reports", [&]() {
+            const int32_t firstPayDate = paymentLedger.empty() ? 0 : paymentLedger.columns.payDates[0];
+            const PayrollReport additionPayrollReport = createAdditionPayrollReportOfPayDates(paymentLedger, firstPayDate, firstPayDate + 7);
+            printPayDatesPayrollReports(firstPayDate, firstPayDate + 7, additionPayrollReport, createAveragePayrollReportFromAddition(additionPayrollReport));
+        });
+        checkTable("all_employees_reports", [&]() { printAllEmployeesPayrollReports(createAllEmployeesPayrollReportSummaries(paymentLedger, BY_NET_PAY)); });
+        checkTable("scenario_comparison", [&]() {
+            const vector<PayrollReport> simulatedReports = simulatePayrollScenarios(paymentLedger.columns, {currentScenario, costlierScenario}, threadPool);
+            TableRenderer tableRenderer(cout);
+            printPayrollScenarioComparisonTable(tableRenderer, costlierScenario, simulatedReports[0], simulatedReports[1]);
+        });
+        if (!employeeRegistry.empty()) {
+            const Employee &widestEmployee = employeeRegistry.employees[employeeRegistry.size() - 1];
+            checkTable("employee_reports", [&]() {
+                printEmployeePayrollReports(createAdditionEmployeePayrollReport(paymentLedger, widestEmployee), createAverageEmployeePayrollReport(paymentLedger, widestEmployee));
+            });
+        }
+    }
+}
+
+// A version 5 ledger file (the same layout, but with the money of its report in dollars) still opens, with its report rebuilt from its payments, & gets saved as the current version
+void testLedgerFileMigration() {
+    EmployeeRegistry employeeRegistry;
+    PaymentLedger paymentLedger;
+    fillGoldenPayroll(employeeRegistry, paymentLedger, GOLDEN_EMPLOYEES.size(), GOLDEN_HOURS_WORKED.size());
+    const PayrollReport &runningReport = paymentLedger.companyAdditionPayrollReport;
+    const string path = (filesystem::temp_directory_path() / "payroll_tests_migration.ledger").string();
+    check(saveLedgerFile(path, employeeRegistry, paymentLedger), "the ledger file " + path + " should be saved");
+
+    // The header gets turned into a version 5 one, with its money in dollars
+    {
+        fstream file(path, ios::in | ios::out | ios::binary);
+        LedgerFileHeader header;
+        file.read(reinterpret_cast<char *>(&header), sizeof(header));
+        header.version = DOLLARS_REPORT_LEDGER_FILE_VERSION;
+        const double dollars[] = {runningReport.regPay.dollars(), runningReport.otPay.dollars(), runningReport.fica.dollars(), runningReport.socSec.dollars()};
+        memcpy(&header.reportRegPayCents, &dollars[0], sizeof(double));
+        memcpy(&header.reportOtPayCents, &dollars[1], sizeof(double));
+        memcpy(&header.reportFicaCents, &dollars[2], sizeof(double));
+        memcpy(&header.reportSocSecCents, &dollars[3], sizeof(double));
+        file.seekp(0);
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        check(static_cast<bool>(file), "the ledger file " + path + " should be turned into a version 5 one");
+    }
+
+    const auto checkSameReport = [&](const PayrollReport &report, const string &description) {
+        check(report.paymentsAmount == runningReport.paymentsAmount && isSameDouble(report.regHours, runningReport.regHours) && isSameDouble(report.otHours, runningReport.otHours) &&
+              report.regPay == runningReport.regPay && report.otPay == runningReport.otPay && report.fica == runningReport.fica && report.socSec == runningReport.socSec, description);
+    };
+    {
+        MappedLedgerFile ledgerFile;
+        check(openLedgerFile(path, ledgerFile) == LEDGER_FILE_OPENED, "a version 5 ledger file should still be opened");
+        if (ledgerFile.header == nullptr) return;
+        checkSameReport(getLedgerFilePayrollReport(ledgerFile), "the report of a version 5 ledger file should be rebuilt from its payments");
+
+        EmployeeRegistry loadedEmployeeRegistry;
+        PaymentLedger loadedPaymentLedger;
+        loadLedgerFile(ledgerFile, loadedEmployeeRegistry, loadedPaymentLedger);
+        check(saveLedgerFile(path, loadedEmployeeRegistry, loadedPaymentLedger), "the migrated ledger file " + path + " should be saved");
+    }
+    {
+        MappedLedgerFile ledgerFile;
+        check(openLedgerFile(path, ledgerFile) == LEDGER_FILE_OPENED && ledgerFile.header->version == LEDGER_FILE_VERSION, "a migrated ledger file should be saved as the current version");
+        if (ledgerFile.header != nullptr) checkSameReport(getLedgerFilePayrollReport(ledgerFile), "a migrated ledger file should keep the rebuilt report");
+    }
+    filesystem::remove(path);
+}
+
+
+// A ledger file with an unknown payroll policy (of a payment or an employee), or with amounts of payments by policy other than its payments', can't be used
+void testLedgerFilePayrollPoliciesValidation() {
+    EmployeeRegistry employeeRegistry;
+    PaymentLedger paymentLedger;
+    fillGoldenPayroll(employeeRegistry, paymentLedger, GOLDEN_EMPLOYEES.size(), GOLDEN_HOURS_WORKED.size());
+    const string path = (filesystem::temp_directory_path() / "payroll_tests_policies.ledger").string();
+
+    // Saves the ledger file again, changing its bytes through a given function, & checks how it gets opened
+    const auto checkOpening = [&](const function<void(string &, LedgerFileHeader &)> &corrupt, const LedgerFileOpening expectedOpening, const string &description) {
+        check(saveLedgerFile(path, employeeRegistry, paymentLedger), "the ledger file " + path + " should be saved");
+        string bytes;
+        {
+            ifstream file(path, ios::binary);
+            bytes.assign(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+        }
+        LedgerFileHeader header;
+        memcpy(&header, bytes.data(), sizeof(header));
+        corrupt(bytes, header);
+        memcpy(bytes.data(), &header, sizeof(header));
+        {
+            ofstream file(path, ios::binary | ios::trunc);
+            file.write(bytes.data(), static_cast<streamsize>(bytes.size()));
+        }
+        MappedLedgerFile ledgerFile;
+        check(openLedgerFile(path, ledgerFile) == expectedOpening, "a ledger file with " + description + (expectedOpening == LEDGER_FILE_OPENED ? " should" : " should not") + " be opened");
+    };
+    checkOpening([](string &, LedgerFileHeader &) {}, LEDGER_FILE_OPENED, "nothing changed");
+    checkOpening([](string &bytes, LedgerFileHeader &header) { bytes[header.payrollPoliciesOffset + 1] = static_cast<char>(PAYROLL_POLICIES_AMOUNT); },
+                 LEDGER_FILE_UNUSABLE, "an unknown payroll policy in a payment");
+    checkOpening([](string &bytes, LedgerFileHeader &header) {
+        bytes[header.employeesOffset + offsetof(LedgerFileEmployee, payrollPolicy)] = static_cast<char>(0xFF);
+    }, LEDGER_FILE_UNUSABLE, "an unknown payroll policy in an employee");
+    checkOpening([](string &, LedgerFileHeader &header) { header.paymentsAmountsByPolicy[STANDARD_PAYROLL_POLICY]++; }, LEDGER_FILE_UNUSABLE, "too many payments of a payroll policy");
+    checkOpening([](string &bytes, LedgerFileHeader &header) {
+        // A payment moved to another known policy keeps the total amount right, but not the amounts of each policy
+        const auto payrollPolicy = static_cast<PayrollPolicy>(bytes[header.payrollPoliciesOffset]);
+        bytes[header.payrollPoliciesOffset] = static_cast<char>((payrollPolicy + 1) % PAYROLL_POLICIES_AMOUNT);
+    }, LEDGER_FILE_UNUSABLE, "a payment of a payroll policy miscounted in its header");
+    filesystem::remove(path);
+}
+
+// A write-ahead log ending in a torn record, a record with a bad checksum, or a header claiming an absurd payload length gets every record before it
+// replayed, & gets cut right before it (without ever allocating that length)
+void testWriteAheadLogReplay() {
+    EmployeeRegistry employeeRegistry;
+    PaymentLedger paymentLedger;
+    fillGoldenPayroll(employeeRegistry, paymentLedger, GOLDEN_EMPLOYEES.size(), 2);
+    const string path = (filesystem::temp_directory_path() / "payroll_tests_replay.ledger.wal").string();
+    filesystem::remove(path);
+    {
+        WriteAheadLog writeAheadLog(path, DEFAULT_GROUP_COMMIT_RECORDS, 0);
+        for (const Employee &employee: employeeRegistry.employees) logEmployeeAddition(writeAheadLog, employee);
+        for (size_t i = 0; i < paymentLedger.size(); i++) logPaymentAddition(writeAheadLog, getPayment(paymentLedger, i));
+    }
+    const size_t recordsAmount = employeeRegistry.employees.size() + paymentLedger.size();
+
+    // The log gets split right before its last record, which then gets damaged in several ways
+    string logBytes;
+    {
+        ifstream file(path, ios::binary);
+        logBytes.assign(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+    }
+    size_t lastRecordOffset = 0;
+    for (size_t offset = 0; offset + sizeof(LogRecordHeader) <= logBytes.size();) {
+        LogRecordHeader recordHeader;
+        memcpy(&recordHeader, logBytes.data() + offset, sizeof(recordHeader));
+        lastRecordOffset = offset;
+        offset += sizeof(recordHeader) + recordHeader.payloadLength;
+    }
+    const string validBytes = logBytes.substr(0, lastRecordOffset);
+    const string lastRecord = logBytes.substr(lastRecordOffset);
+    string badChecksumRecord = lastRecord;
+    badChecksumRecord.back() ^= 0x01;
+    string oversizedRecord = lastRecord;
+    const uint32_t oversizedLength = 0xFFFFFFF0;
+    memcpy(oversizedRecord.data() + offsetof(LogRecordHeader, payloadLength), &oversizedLength, sizeof(oversizedLength));
+
+    const auto checkReplay = [&](const string &bytes, const size_t expectedRecordsAmount, const size_t expectedSize, const string &description) {
+        {
+            ofstream file(path, ios::binary | ios::trunc);
+            file.write(bytes.data(), static_cast<streamsize>(bytes.size()));
+        }
+        EmployeeRegistry replayedEmployeeRegistry;
+        PaymentLedger replayedPaymentLedger;
+        uint64_t lastSequenceNumber = 0;
+        const size_t appliedRecords = replayWriteAheadLog(path, 0, replayedEmployeeRegistry, replayedPaymentLedger, lastSequenceNumber);
+        check(appliedRecords == expectedRecordsAmount && lastSequenceNumber == expectedRecordsAmount,
+              "a log with " + description + " should get " + to_string(expectedRecordsAmount) + " records replayed, not " + to_string(appliedRecords));
+        error_code errorCode;
+        const uintmax_t size = filesystem::file_size(path, errorCode);
+        check(!errorCode && size == expectedSize, "a log with " + description + " should be left with " + to_string(expectedSize) + " bytes, not " + to_string(size));
+    };
+    checkReplay(logBytes, recordsAmount, logBytes.size(), "only valid records");
+    checkReplay(validBytes + lastRecord.substr(0, lastRecord.size() - 1), recordsAmount - 1, validBytes.size(), "a torn tail");
+    checkReplay(validBytes + lastRecord.substr(0, sizeof(LogRecordHeader) - 1), recordsAmount - 1, validBytes.size(), "a torn header");
+    checkReplay(validBytes + badChecksumRecord, recordsAmount - 1, validBytes.size(), "a bad checksum");
+    checkReplay(validBytes + oversizedRecord, recordsAmount - 1, validBytes.size(), "an oversized payload length");
+    checkReplay(oversizedRecord, 0, 0, "an oversized payload length right at the beginning");
+    filesystem::remove(path);
+}
+
+
+/**
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                         *
+ *                    MAIN FUNCTION                        *
+ *                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ **/
+
+
+int main(const int argc, char *argv[]) {
+    const vector<string> inputs = getCheckedInputs(EXHAUSTIVE_INPUTS_ALPHABET, EXHAUSTIVE_INPUTS_LENGTH, RANDOM_INPUTS_AMOUNT);
+    testTypedNumbersParsing(inputs);
+    testIntegersParsing(inputs);
+    testCsvDoublesParsing(inputs);
+    testMoneyRounding();
+    testKernelsMoneyRounding();
+    testMoneyFormatting();
+    testReportTables(argc > 1 ? argv[1] : DEFAULT_GOLDEN_FILES_DIRECTORY);
+    testLedgerFileMigration();
+    testLedgerFilePayrollPoliciesValidation();
+    testWriteAheadLogReplay();
+
+    if (failedChecksAmount > 0) {
+        cerr << failedChecksAmount << " check" << (failedChecksAmount == 1 ? "" : "s") << " failed." << endl;
+        return 1;
+    }
+    cout << "Every check passed, over " << inputs.size() << " inputs." << endl;
+    return 0;
+}